@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#include <new>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unp.hpp>
+
+// g++ -std=c++23 -Wall -O3 -Os -s -I example -I include example/echo_allocations.cpp -o /tmp/echo_allocations
+
+namespace net = unp;
+
+using udp = net::ip::udp;
+using socket_t = udp::socket;
+
+static constexpr int max_length = 64;
+using context_t = net::io_uring_context;
+
+static std::atomic<std::size_t> allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+class echo_bench
+{
+public:
+    echo_bench(context_t& ioc, net::inplace_stop_source& source, const udp::endpoint& server_endpoint, const udp::endpoint& client_endpoint, std::size_t rounds) :
+    source(source), server(ioc, server_endpoint), client(ioc, client_endpoint), server_endpoint(server_endpoint), rounds(rounds)
+    {
+        do_server_receive();
+        do_client_send();
+    }
+
+    void do_server_receive()
+    {
+        net::async_receive_from(server, net::buffer(server_data, max_length), sender,
+        [this](std::error_code ec, std::size_t bytes_transferred)
+        {
+            if (!ec)
+                do_server_send(bytes_transferred);
+        });
+    }
+
+    void do_server_send(std::size_t length)
+    {
+        net::async_send_to(server, net::buffer(server_data, length), sender,
+        [this](std::error_code ec, std::size_t bytes_transferred)
+        {
+            if (!ec)
+                do_server_receive();
+        });
+    }
+
+    void do_client_send()
+    {
+        net::async_send_to(client, net::buffer(client_data, max_length), server_endpoint,
+        [this](std::error_code ec, std::size_t bytes_transferred)
+        {
+            if (!ec)
+                do_client_receive();
+        });
+    }
+
+    void do_client_receive()
+    {
+        net::async_receive_from(client, net::buffer(client_data, max_length), peer,
+        [this](std::error_code ec, std::size_t bytes_transferred)
+        {
+            if (ec)
+                return (void)source.request_stop();
+
+            on_round_trip();
+        });
+    }
+
+    void on_round_trip()
+    {
+        if (++count == warmup)
+        {
+            start = std::chrono::steady_clock::now();
+            baseline = allocations.load(std::memory_order_relaxed);
+        }
+
+        if (count == warmup + rounds)
+        {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            auto total = allocations.load(std::memory_order_relaxed) - baseline;
+
+            std::cout << "round trips " << rounds << " allocations " << total
+                      << " per round trip " << static_cast<double>(total) / rounds
+                      << " ns per round trip " << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / rounds << std::endl;
+
+            return (void)source.request_stop();
+        }
+
+        do_client_send();
+    }
+
+private:
+    net::inplace_stop_source& source;
+
+    socket_t server;
+    socket_t client;
+
+    udp::endpoint server_endpoint;
+    udp::endpoint sender;
+    udp::endpoint peer;
+
+    std::size_t rounds;
+    std::size_t count = 0;
+
+    std::size_t warmup = 1000;
+    std::size_t baseline = 0;
+
+    std::chrono::steady_clock::time_point start;
+
+    char server_data[max_length];
+    char client_data[max_length] = {};
+};
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc != 4)
+        {
+            std::cerr << "Usage: " << argv[0] << " <host> <port> <rounds>" << std::endl;
+
+            return 1;
+        }
+
+        context_t ioc;
+        net::inplace_stop_source source;
+
+        auto address = net::ip::make_address(argv[1]);
+        int port = std::atoi(argv[2]);
+
+        echo_bench b(ioc, source, udp::endpoint(address, port), udp::endpoint(address, port + 1), std::atoll(argv[3]));
+        ioc.run(source.get_token());
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#include <iostream>
+#include <unp.hpp>
+
+// g++ -std=c++23 -Wall -O3 -Os -s -I example -I include example/echo_server_tcp_awaitable.cpp -o /tmp/echo_server_tcp_awaitable
+
+namespace net = unp;
+
+using tcp = net::ip::tcp;
+using socket_t = tcp::socket;
+
+static constexpr int max_length = 1024;
+using context_t = net::io_uring_context;
+
+net::task<> echo(socket_t socket, net::inplace_stop_token token)
+{
+    char data[max_length];
+
+    while (true)
+    {
+        auto [ec, length] = co_await net::async_read_some(socket, net::buffer(data, max_length), token, net::use_awaitable);
+
+        if (ec)
+        {
+            if (ec != std::errc::no_message)
+                std::cout << "async_read_some " << ec.message() << std::endl;
+
+            break;
+        }
+
+        auto [error, bytes_transferred] = co_await net::async_write(socket, net::buffer(data, length), net::use_awaitable);
+
+        if (error)
+        {
+            std::cout << "async_write " << error.message() << std::endl;
+
+            break;
+        }
+    }
+}
+
+net::task<> listen(net::async_scope& scope, tcp::acceptor& acceptor)
+{
+    while (true)
+    {
+        auto [ec, socket] = co_await acceptor.async_accept(net::use_awaitable);
+
+        if (ec)
+        {
+            std::cout << "async_accept " << ec.message() << std::endl;
+
+            break;
+        }
+
+        scope.spawn(echo(std::move(socket), scope.get_stop_token()));
+    }
+
+    scope.request_stop();
+    co_await scope.join();
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        if (argc != 3)
+        {
+            std::cerr << "Usage: " << argv[0] << " <host> <port>" << std::endl;
+
+            return 1;
+        }
+
+        context_t ioc;
+        net::inplace_stop_source source;
+
+        auto address = net::ip::make_address(argv[1]);
+        tcp::acceptor acceptor(ioc, tcp::endpoint(address, std::atoi(argv[2])));
+
+        net::async_scope scope(ioc);
+
+        net::spawn(ioc, listen(scope, acceptor));
+        ioc.run(source.get_token());
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Exception: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
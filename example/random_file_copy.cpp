@@ -26,7 +26,7 @@ class file_copier
 {
 public:
     file_copier(context_t& ioc, const std::string& from, const std::string& to) :
-    from(ioc, from, file::read_only), to(ioc, to, file::write_only | file::create | file::truncate)
+    from(ioc, from, file::read_only), to(ioc, to, file::write_only | file::create | file::truncate), chain(ioc), size(fs::file_size(from))
     {
         fs::file_status s = fs::status(from);
         fs::permissions(to, s.permissions());
@@ -34,31 +34,45 @@ public:
 
     void start()
     {
-        do_read();
+        do_copy();
     }
 
-    void do_read()
+    void do_copy()
     {
-        net::async_read_some_at(from, offset, net::buffer(buff),
-        [this](std::error_code ec, std::size_t bytes_transferred)
+        if (offset == size)
+        {
+            source.request_stop();
+
+            return;
+        }
+
+        std::size_t length = std::min<std::size_t>(buff.size(), size - offset);
+
+        chain.clear();
+        chain.read(from, offset, net::buffer(buff.data(), length)).write(to, offset, net::buffer(buff.data(), length));
+
+        chain.async_submit([this, length](std::error_code ec, std::span<const int> results)
         {
-            on_read(ec, bytes_transferred);
+            on_copy(ec, results, length);
         });
     }
 
-    void on_read(std::error_code ec, std::size_t bytes_transferred)
+    void on_copy(std::error_code ec, std::span<const int> results, std::size_t length)
     {
-        if (ec)
+        if (!ec)
         {
-            if (ec != std::errc::no_message)
-                std::cout << "async_read " << ec.message() << std::endl;
+            offset += length;
+            do_copy();
+        }
+        else if (results[0] > 0 && results[1] == -ECANCELED)
+            do_write(results[0]);
+        else
+        {
+            if (results[0] != 0)
+                std::cout << "async_copy " << ec.message() << std::endl;
 
             source.request_stop();
-
-            return;
         }
-
-        do_write(bytes_transferred);
     }
 
     void do_write(std::size_t length)
@@ -83,14 +97,18 @@ public:
         }
 
         offset += bytes_transferred;
-        do_read();
+        do_copy();
     }
 
 private:
     file from;
     file to;
 
+    net::chain chain;
+
     int64_t offset = 0;
+    int64_t size;
+
     std::array<char, 4096> buff;
 };
 
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#include <thread>
+#include <iostream>
+#include <unistd.h>
+#include <unp.hpp>
+
+// g++ -std=c++23 -Wall -O3 -Os -s -I example -I include example/small_ring.cpp -o /tmp/small_ring
+
+namespace net = unp;
+using context_t = net::io_uring_context;
+
+int main(int argc, char* argv[])
+{
+    net::context_options options;
+    options.sq_entries = 4;
+
+    context_t ctx(options);
+
+    int fds[2];
+    int timed_fds[2];
+
+    if (pipe(fds) < 0 || pipe(timed_fds) < 0)
+    {
+        std::cerr << "pipe failed" << std::endl;
+
+        return 1;
+    }
+
+    net::async_file reader(ctx, fds[0]);
+    net::async_file timed_reader(ctx, timed_fds[0]);
+
+    constexpr int plain_count = 3;
+    constexpr int timed_count = 8;
+
+    int completed = 0;
+    int timed_out = 0;
+
+    char data[plain_count];
+    char timed_data[timed_count];
+
+    net::inplace_stop_source source;
+
+    auto on_complete = [&]
+    {
+        if (++completed == plain_count + timed_count)
+            source.request_stop();
+    };
+
+    for (int i = 0; i < plain_count; ++i)
+    {
+        net::async_read_some(reader, net::buffer(data + i, 1), [&](std::error_code ec, std::size_t n)
+        {
+            if (ec)
+                std::cout << "read " << ec.message() << std::endl;
+
+            on_complete();
+        });
+    }
+
+    for (int i = 0; i < timed_count; ++i)
+    {
+        net::async_read_some(timed_reader, net::buffer(timed_data + i, 1), net::deadline(std::chrono::milliseconds(50)), [&](std::error_code ec, std::size_t n)
+        {
+            if (ec)
+                ++timed_out;
+
+            if (timed_out == timed_count)
+                ::write(fds[1], "abc", plain_count);
+
+            on_complete();
+        });
+    }
+
+    std::thread watchdog([&]
+    {
+        for (int i = 0; i < 500 && !source.stop_requested(); ++i)
+             std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        if (!source.stop_requested())
+        {
+            std::cerr << "stalled with " << completed << " of " << plain_count + timed_count << " completed" << std::endl;
+            std::_Exit(1);
+        }
+    });
+
+    ctx.run(source.get_token());
+    watchdog.join();
+
+    std::cout << timed_out << " timed out, " << completed << " completed" << std::endl;
+
+    ::close(fds[1]);
+    ::close(timed_fds[1]);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#include <deque>
+#include <chrono>
+#include <iostream>
+#include <unp.hpp>
+
+// g++ -std=c++23 -Wall -O3 -Os -s -I example -I include example/timer_heap.cpp -o /tmp/timer_heap
+
+namespace net = unp;
+using context_t = net::io_uring_context;
+
+class timer_bench
+{
+public:
+    timer_bench(context_t& ctx, std::size_t idle, std::size_t cycles) : ctx(ctx), timer(ctx), idle(idle), cycles(cycles)
+    {
+    }
+
+    void start()
+    {
+        for (std::size_t i = 0; i < idle; ++i)
+        {
+             auto& t = timers.emplace_back(ctx);
+
+             t.expires_after(std::chrono::seconds(3600 + i % 3600));
+             t.async_wait([](std::error_code){});
+        }
+
+        begin = std::chrono::steady_clock::now();
+        arm();
+    }
+
+    void arm()
+    {
+        timer.expires_after(std::chrono::seconds(1 + count % 7200));
+        timer.async_wait([this](std::error_code ec)
+        {
+            if (ec != std::errc::operation_canceled)
+                std::cout << "unexpected " << ec.message() << std::endl;
+
+            if (++count < cycles)
+                arm();
+            else
+                finish();
+        });
+
+        timer.cancel();
+    }
+
+    void finish()
+    {
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        std::cout << count << " arm/cancel cycles with " << idle << " idle timers: " << elapsed << " s, "
+                  << elapsed * 1e9 / count << " ns/cycle" << std::endl;
+
+        for (auto& t : timers)
+             t.cancel();
+
+        source.request_stop();
+    }
+
+    context_t& ctx;
+    net::steady_timer timer;
+
+    std::size_t idle;
+    std::size_t cycles;
+
+    std::size_t count = 0;
+    std::deque<net::steady_timer> timers;
+
+    std::chrono::steady_clock::time_point begin;
+    net::inplace_stop_source source;
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <idle timers> <cycles>" << std::endl;
+
+        return 1;
+    }
+
+    context_t ctx;
+    timer_bench bench(ctx, std::atoi(argv[1]), std::atoi(argv[2]));
+
+    net::steady_timer starter(ctx);
+
+    starter.async_wait([&](std::error_code)
+    {
+        bench.start();
+    });
+
+    ctx.run(bench.source.get_token());
+
+    return 0;
+}
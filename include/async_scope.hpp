@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef ASYNC_SCOPE_HPP
+#define ASYNC_SCOPE_HPP
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace unp
+{
+    class async_scope
+    {
+    public:
+        struct scope_task
+        {
+            struct promise_type
+            {
+                struct final_awaiter
+                {
+                    bool await_ready() const noexcept
+                    {
+                        return false;
+                    }
+
+                    void await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                    {
+                        auto& scope = h.promise().scope;
+
+                        h.destroy();
+                        scope.arrive();
+                    }
+
+                    void await_resume() noexcept
+                    {
+                    }
+                };
+
+                template <typename... Args>
+                explicit promise_type(async_scope& scope, Args&&...) noexcept : scope(scope)
+                {
+                }
+
+                static void* operator new(std::size_t size)
+                {
+                    return allocate_frame(size);
+                }
+
+                static void operator delete(void* p, std::size_t size) noexcept
+                {
+                    deallocate_frame(p, size);
+                }
+
+                scope_task get_return_object() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() noexcept
+                {
+                    return {};
+                }
+
+                final_awaiter final_suspend() noexcept
+                {
+                    return {};
+                }
+
+                void return_void() noexcept
+                {
+                }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+
+                async_scope& scope;
+            };
+        };
+
+        struct join_awaiter : operation_base
+        {
+            explicit join_awaiter(async_scope& scope) noexcept : scope(scope)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return scope.count.load(std::memory_order_acquire) == 0;
+            }
+
+            bool await_suspend(std::coroutine_handle<> h) noexcept
+            {
+                handle = h;
+                execute_ = &join_awaiter::on_join_complete;
+
+                scope.joiner.store(this, std::memory_order_release);
+
+                if (scope.count.load(std::memory_order_acquire) != 0)
+                    return true;
+
+                return scope.joiner.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+            }
+
+            static void on_join_complete(operation_base* op) noexcept
+            {
+                static_cast<join_awaiter*>(op)->handle.resume();
+            }
+
+            void await_resume()
+            {
+                if (auto e = std::exchange(scope.exception, nullptr))
+                    std::rethrow_exception(e);
+            }
+
+            async_scope& scope;
+            std::coroutine_handle<> handle;
+        };
+
+        explicit async_scope(io_uring_context& context) noexcept : context(context)
+        {
+        }
+
+        async_scope(const async_scope&) = delete;
+        async_scope& operator=(const async_scope&) = delete;
+
+        void spawn(task<void> t)
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+            run(*this, std::move(t));
+        }
+
+        void request_stop() noexcept
+        {
+            source.request_stop();
+        }
+
+        inplace_stop_token get_stop_token() noexcept
+        {
+            return source.get_token();
+        }
+
+        bool stop_requested() const noexcept
+        {
+            return source.stop_requested();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return count.load(std::memory_order_relaxed);
+        }
+
+        join_awaiter join() noexcept
+        {
+            return join_awaiter(*this);
+        }
+
+        ~async_scope()
+        {
+            assert(count.load(std::memory_order_relaxed) == 0);
+        }
+
+    private:
+        static scope_task run(async_scope& scope, task<void> t)
+        {
+            co_await schedule_awaiter(scope.context);
+
+            try
+            {
+                co_await std::move(t);
+            }
+            catch (...)
+            {
+                if (!scope.exception)
+                    scope.exception = std::current_exception();
+            }
+        }
+
+        void arrive() noexcept
+        {
+            if (count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (auto op = joiner.exchange(nullptr, std::memory_order_acq_rel))
+                context.schedule_impl(op);
+        }
+
+        io_uring_context& context;
+        inplace_stop_source source;
+
+        std::atomic<std::size_t> count = 0;
+        std::atomic<join_awaiter*> joiner = nullptr;
+
+        std::exception_ptr exception;
+    };
+}
+
+#endif
@@ -10,114 +10,207 @@
 #ifndef INTRUSIVE_HEAP_HPP
 #define INTRUSIVE_HEAP_HPP
 
+#include <cassert>
+#include <cstddef>
+
 namespace unp
 {
-    template <typename T, T* T::*NEXT, T* T::*PREV, typename U, U T::*KEY>
+    template <typename T, T* T::*PARENT, T* T::*LEFT, T* T::*RIGHT, typename U, U T::*KEY>
     class intrusive_heap
     {
     public:
-        intrusive_heap() noexcept : head(nullptr)
+        intrusive_heap() noexcept : root(nullptr), count(0)
         {
         }
 
         bool empty() const noexcept
         {
-            return head == nullptr;
+            return root == nullptr;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return count;
+        }
+
+        bool contains(const T* item) const noexcept
+        {
+            return item == root || item->*PARENT != nullptr;
         }
 
         T* top() const noexcept
         {
             assert(!empty());
 
-            return head;
+            return root;
         }
 
         T* pop() noexcept
         {
             assert(!empty());
-            T* item = head;
-
-            head = item->*NEXT;
+            T* item = root;
 
-            if (head != nullptr)
-                head->*PREV = nullptr;
+            remove(item);
 
             return item;
         }
 
         void insert(T* item) noexcept
         {
-            if (head == nullptr)
-            {
-                head = item;
+            item->*PARENT = nullptr;
+            item->*LEFT = nullptr;
+
+            item->*RIGHT = nullptr;
+            T** slot = &root;
 
-                item->*NEXT = nullptr;
-                item->*PREV = nullptr;
+            T* parent = nullptr;
+            auto n = ++count;
+
+            for (auto bit = top_bit(n) >> 1; bit != 0; bit >>= 1)
+            {
+                 parent = *slot;
+                 slot = (n & bit) != 0 ? &(parent->*RIGHT) : &(parent->*LEFT);
             }
-            else if (item->*KEY < head->*KEY)
+
+            item->*PARENT = parent;
+            *slot = item;
+
+            while (item->*PARENT != nullptr && item->*KEY < item->*PARENT->*KEY)
+                   swap(item->*PARENT, item);
+        }
+
+        void remove(T* item) noexcept
+        {
+            assert(contains(item));
+            T** slot = &root;
+
+            auto n = count--;
+
+            for (auto bit = top_bit(n) >> 1; bit != 0; bit >>= 1)
+                 slot = (n & bit) != 0 ? &((*slot)->*RIGHT) : &((*slot)->*LEFT);
+
+            T* last = *slot;
+            *slot = nullptr;
+
+            if (last == item)
+                return reset(item);
+
+            last->*PARENT = item->*PARENT;
+            last->*LEFT = item->*LEFT;
+
+            last->*RIGHT = item->*RIGHT;
+            relink(last, item);
+
+            reset(item);
+
+            while (true)
             {
-                item->*NEXT = head;
-                item->*PREV = nullptr;
+                T* smallest = last;
+
+                if (last->*LEFT != nullptr && last->*LEFT->*KEY < smallest->*KEY)
+                    smallest = last->*LEFT;
+
+                if (last->*RIGHT != nullptr && last->*RIGHT->*KEY < smallest->*KEY)
+                    smallest = last->*RIGHT;
 
-                head->*PREV = item;
-                head = item;
+                if (smallest == last)
+                    break;
+
+                swap(last, smallest);
             }
-            else
-            {
-                auto* insert_next = head;
 
-                while (insert_next->*NEXT != nullptr && insert_next->*NEXT->*KEY <= item->*KEY)
-                       insert_next = insert_next->*NEXT;
+            while (last->*PARENT != nullptr && last->*KEY < last->*PARENT->*KEY)
+                   swap(last->*PARENT, last);
+        }
+
+        ~intrusive_heap()
+        {
+            assert(empty());
+        }
+
+    private:
+        static std::size_t top_bit(std::size_t n) noexcept
+        {
+            std::size_t bit = 1;
 
-                auto* insert_prev = insert_next->*NEXT;
+            while (n >>= 1)
+                   bit <<= 1;
 
-                item->*PREV = insert_next;
-                item->*NEXT = insert_prev;
+            return bit;
+        }
 
-                insert_next->*NEXT = item;
+        static void reset(T* item) noexcept
+        {
+            item->*PARENT = nullptr;
+            item->*LEFT = nullptr;
 
-                if (insert_prev != nullptr)
-                    insert_prev->*PREV = item;
-            }
+            item->*RIGHT = nullptr;
         }
 
-        void remove(T* item) noexcept
+        void relink(T* node, T* old) noexcept
         {
-            auto* prev = item->*PREV;
-            auto* next = item->*NEXT;
+            if (node->*LEFT != nullptr)
+                node->*LEFT->*PARENT = node;
 
-            if (prev != nullptr)
-                prev->*NEXT = next;
-            else
-            {
-                assert(head == item);
-                head = next;
-            }
+            if (node->*RIGHT != nullptr)
+                node->*RIGHT->*PARENT = node;
+
+            T* parent = node->*PARENT;
 
-            if (next != nullptr)
-                next->*PREV = prev;
+            if (parent == nullptr)
+                root = node;
+            else if (parent->*LEFT == old)
+                parent->*LEFT = node;
+            else
+                parent->*RIGHT = node;
         }
 
-        ~intrusive_heap()
+        void swap(T* parent, T* child) noexcept
         {
-            T* item = head;
+            T* left = child->*LEFT;
+            T* right = child->*RIGHT;
 
-            if (item != nullptr)
-                assert(item->*PREV == nullptr);
+            child->*PARENT = parent->*PARENT;
 
-            while (item != nullptr)
+            if (parent->*LEFT == child)
             {
-                if (item->*NEXT != nullptr)
-                    assert(item->*NEXT->*PREV == item);
-
-                item = item->*NEXT;
+                child->*LEFT = parent;
+                child->*RIGHT = parent->*RIGHT;
+            }
+            else
+            {
+                child->*LEFT = parent->*LEFT;
+                child->*RIGHT = parent;
             }
 
-            assert(empty());
+            parent->*LEFT = left;
+            parent->*RIGHT = right;
+
+            parent->*PARENT = child;
+
+            if (left != nullptr)
+                left->*PARENT = parent;
+
+            if (right != nullptr)
+                right->*PARENT = parent;
+
+            T* sibling = child->*LEFT == parent ? child->*RIGHT : child->*LEFT;
+
+            if (sibling != nullptr)
+                sibling->*PARENT = child;
+
+            T* grand = child->*PARENT;
+
+            if (grand == nullptr)
+                root = child;
+            else if (grand->*LEFT == parent)
+                grand->*LEFT = child;
+            else
+                grand->*RIGHT = child;
         }
 
-    private:
-        T* head;
+        T* root;
+        std::size_t count;
     };
 }
 
@@ -95,6 +95,29 @@ namespace unp
             tail = item;
         }
 
+        bool remove(T* item) noexcept
+        {
+            T* prev = nullptr;
+
+            for (T* curr = head; curr != nullptr; prev = curr, curr = curr->*NEXT)
+            {
+                 if (curr != item)
+                     continue;
+
+                 if (prev == nullptr)
+                     head = curr->*NEXT;
+                 else
+                     prev->*NEXT = curr->*NEXT;
+
+                 if (tail == curr)
+                     tail = prev;
+
+                 return true;
+            }
+
+            return false;
+        }
+
         void append(intrusive_queue other) noexcept
         {
             if (other.empty())
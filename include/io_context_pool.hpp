@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_CONTEXT_POOL_HPP
+#define IO_CONTEXT_POOL_HPP
+
+#include <memory>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <sched.h>
+#include <pthread.h>
+
+namespace unp
+{
+    enum class context_selection
+    {
+        round_robin,
+        least_loaded
+    };
+
+    class io_context_pool
+    {
+    public:
+        explicit io_context_pool(std::size_t size = std::thread::hardware_concurrency(), const context_options& options = {},
+        context_selection selection = context_selection::round_robin) : selection(selection)
+        {
+            size = std::max<std::size_t>(size, 1);
+            sources = std::make_unique<inplace_stop_source[]>(size);
+
+            for (std::size_t i = 0; i < size; ++i)
+                 contexts.push_back(std::make_unique<io_uring_context>(options));
+
+            init_cpus();
+        }
+
+        void init_cpus()
+        {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            {
+                for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                {
+                     if (CPU_ISSET(cpu, &set))
+                         cpus.push_back(cpu);
+                }
+            }
+        }
+
+        void run(bool pin = true)
+        {
+            assert(threads.empty());
+
+            for (std::size_t i = 0; i < contexts.size(); ++i)
+            {
+                 threads.emplace_back([this, i, pin]
+                 {
+                     if (pin && !cpus.empty())
+                         pin_thread(cpus[i % cpus.size()]);
+
+                     contexts[i]->run(sources[i].get_token());
+                 });
+            }
+        }
+
+        static void pin_thread(int cpu) noexcept
+        {
+            cpu_set_t set;
+
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+
+        void stop() noexcept
+        {
+            for (std::size_t i = 0; i < contexts.size(); ++i)
+                 sources[i].request_stop();
+        }
+
+        void join()
+        {
+            for (auto& t : threads)
+                 t.join();
+
+            threads.clear();
+        }
+
+        io_uring_context& next_context() noexcept
+        {
+            if (selection == context_selection::least_loaded)
+                return least_loaded_context();
+
+            return *contexts[next_index.fetch_add(1, std::memory_order_relaxed) % contexts.size()];
+        }
+
+        io_uring_context& least_loaded_context() noexcept
+        {
+            auto* result = contexts.front().get();
+
+            for (auto& context : contexts)
+            {
+                 if (context->load() < result->load())
+                     result = context.get();
+            }
+
+            return *result;
+        }
+
+        io_uring_context& operator[](std::size_t i) noexcept
+        {
+            return *contexts[i];
+        }
+
+        std::size_t size() const noexcept
+        {
+            return contexts.size();
+        }
+
+        ~io_context_pool()
+        {
+            stop();
+            join();
+        }
+
+    private:
+        context_selection selection;
+        std::atomic<std::size_t> next_index = 0;
+
+        std::vector<int> cpus;
+        std::vector<std::thread> threads;
+
+        std::unique_ptr<inplace_stop_source[]> sources;
+        std::vector<std::unique_ptr<io_uring_context>> contexts;
+    };
+}
+
+#endif
@@ -17,6 +17,21 @@ namespace unp
     public:
         using socket_t = async_file;
 
+        struct cancel_request : operation_base
+        {
+            explicit cancel_request(acceptor* self) noexcept : self(self)
+            {
+                execute_ = &cancel_request::on_cancel;
+            }
+
+            static void on_cancel(operation_base* op) noexcept
+            {
+                static_cast<cancel_request*>(op)->self->cancel_local();
+            }
+
+            acceptor* self;
+        };
+
         void start() noexcept
         {
             if (!context.is_running_on_io_thread())
@@ -37,12 +52,33 @@ namespace unp
         {
             assert(context.is_running_on_io_thread());
 
+            if (stop.stop_requested() || canceled.load(std::memory_order_acquire))
+            {
+                result = -ECANCELED;
+                flags = 0;
+
+                return on_accept(this);
+            }
+
             auto fill = [this](io_uring_sqe& sqe) noexcept
             {
                 sqe.opcode = IORING_OP_ACCEPT;
                 sqe.accept_flags = SOCK_NONBLOCK;
 
-                sqe.fd = fd_;
+                if (multishot)
+                    sqe.ioprio = IORING_ACCEPT_MULTISHOT;
+
+                if (index_ >= 0)
+                {
+                    sqe.fd = index_;
+                    sqe.flags = IOSQE_FIXED_FILE;
+                }
+                else
+                    sqe.fd = fd_;
+
+                if (direct)
+                    sqe.file_index = IORING_FILE_INDEX_ALLOC;
+
                 sqe.user_data = reinterpret_cast<std::uintptr_t>(static_cast<completion_base*>(this));
 
                 execute_ = &acceptor::on_accept;
@@ -59,42 +95,163 @@ namespace unp
         {
             auto& self = *static_cast<acceptor*>(op);
 
-            if (self.result >= 0)
+            const bool more = (self.flags & IORING_CQE_F_MORE) != 0;
+            const bool rearm = self.multishot && !more && self.should_rearm();
+
+            if (!more && !rearm)
+                self.stop.disarm();
+
+            if (self.result >= 0 && self.direct)
+            {
+                socket_t socket(self.context);
+                socket.reset_direct(self.result);
+
+                self.receiver(std::error_code(), std::move(socket));
+            }
+            else if (self.result >= 0)
                 self.receiver(std::error_code(), socket_t(self.context, self.result));
             else
-                self.receiver(std::error_code(-self.result, std::system_category()), socket_t(self.context));
+                self.receiver(self.stop.error(self.result), socket_t(self.context));
+
+            if (rearm)
+                self.start_io();
+        }
+
+        bool should_rearm() const noexcept
+        {
+            if (canceled.load(std::memory_order_acquire) || stop.stop_requested())
+                return false;
+
+            if (result >= 0)
+                return true;
+
+            const int error = -result;
+
+            return error == ECONNABORTED || error == EINTR || error == EPROTO || error == ENOPROTOOPT || error == EOPNOTSUPP ||
+                   error == ENETDOWN || error == ENETUNREACH || error == EHOSTDOWN || error == EHOSTUNREACH || error == ENONET;
+        }
+
+        explicit acceptor(io_uring_context& context, const unp::ip::tcp::endpoint& endpoint) noexcept : context(context), endpoint(endpoint),
+        canceler(this), stop(context, this)
+        {
         }
 
-        explicit acceptor(io_uring_context& context, const unp::ip::tcp::endpoint& endpoint) noexcept : context(context), endpoint(endpoint)
+        template <typename F>
+        decltype(auto) async_accept(F&& f)
         {
+            return async_accept(inplace_stop_token(), std::forward<F>(f));
         }
 
         template <typename F>
-        void async_accept(F&& f)
+        decltype(auto) async_accept(inplace_stop_token token, F&& f)
+        {
+            if constexpr(is_awaitable_v<F>)
+            {
+                auto start = [this, token](auto f)
+                {
+                    async_accept(token, std::move(f));
+                };
+
+                return completion_awaiter<decltype(start), socket_t>(std::move(start));
+            }
+            else
+            {
+                multishot = false;
+                open_and_accept(token, std::forward<F>(f));
+            }
+        }
+
+        template <typename F>
+        void async_accept_multishot(F&& f)
+        {
+            async_accept_multishot(inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_accept_multishot(inplace_stop_token token, F&& f)
+        {
+            multishot = true;
+            open_and_accept(token, std::forward<F>(f));
+        }
+
+        template <typename F>
+        void open_and_accept(inplace_stop_token token, F&& f)
         {
             if (fd_ < 0)
                 async_socket(context, endpoint.protocol().family(), SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, IPPROTO_TCP,
-                [this, f](std::error_code ec, int fd)
+                [this, token, f = std::forward<F>(f)](std::error_code ec, int fd) mutable
                 {
                     if (!ec)
                     {
                         open_socket(fd);
-                        do_accept(f);
+                        do_accept(token, std::move(f));
                     }
+                    else
+                        f(ec, socket_t(context));
                 });
             else
-                do_accept(f);
+                do_accept(token, std::forward<F>(f));
         }
 
         template <typename F>
-        void do_accept(F&& f)
+        void do_accept(inplace_stop_token token, F&& f)
         {
-            receiver = f;
+            receiver = std::forward<F>(f);
+            canceled.store(false, std::memory_order_release);
+
+            stop.arm(token);
             start();
         }
 
+        void cancel() noexcept
+        {
+            canceled.store(true, std::memory_order_release);
+
+            if (cancel_pending.exchange(true, std::memory_order_acq_rel))
+                return;
+
+            if (context.is_running_on_io_thread())
+                cancel_local();
+            else
+                context.schedule_remote(&canceler);
+        }
+
+        void cancel_local() noexcept
+        {
+            if (!canceled.load(std::memory_order_acquire))
+                return cancel_pending.store(false, std::memory_order_release);
+
+            if (context.remove_pending_io(this))
+            {
+                cancel_pending.store(false, std::memory_order_release);
+
+                result = -ECANCELED;
+                flags = 0;
+
+                return on_accept(this);
+            }
+
+            if (!context.submit_cancel(this))
+                return context.schedule_pending_io(&canceler);
+
+            cancel_pending.store(false, std::memory_order_release);
+        }
+
+        void set_fixed_file(bool value) noexcept
+        {
+            fixed_file = value;
+        }
+
+        void set_direct(bool value) noexcept
+        {
+            direct = value;
+        }
+
         void close()
         {
+            if (index_ >= 0)
+                context.unregister_file(std::exchange(index_, -1));
+
             ::close(fd_);
         }
 
@@ -116,6 +273,9 @@ namespace unp
 
             ret = listen(fd_, 4096);
             assert(ret != -1);
+
+            if (fixed_file)
+                index_ = context.try_register_file(fd_);
         }
 
     private:
@@ -123,7 +283,20 @@ namespace unp
         unp::ip::tcp::endpoint endpoint;
 
         int fd_ = -1;
-        std::function<void(std::error_code, socket_t)> receiver;
+        int index_ = -1;
+
+        bool fixed_file = false;
+        bool direct = false;
+
+        bool multishot = false;
+
+        std::atomic<bool> canceled = false;
+        std::atomic<bool> cancel_pending = false;
+
+        cancel_request canceler;
+        stop_cancel stop;
+
+        unique_function<void(std::error_code, socket_t)> receiver;
     };
 }
 
@@ -0,0 +1,440 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_AWAITABLE_HPP
+#define IO_URING_AWAITABLE_HPP
+
+#include <tuple>
+#include <optional>
+#include <exception>
+#include <coroutine>
+#include <manual_lifetime.hpp>
+
+namespace unp
+{
+    struct use_awaitable_t
+    {
+    };
+
+    inline constexpr use_awaitable_t use_awaitable {};
+
+    struct deferred_start_t
+    {
+    };
+
+    inline constexpr deferred_start_t deferred_start {};
+
+    template <typename F>
+    inline constexpr bool is_awaitable_v = std::is_same_v<std::decay_t<F>, use_awaitable_t>;
+
+    template <typename F>
+    inline constexpr bool is_deferred_v = std::is_same_v<std::decay_t<F>, deferred_start_t>;
+
+    template <typename... R>
+    using awaitable_result_t = std::conditional_t<sizeof...(R) == 0, std::error_code, std::tuple<std::error_code, R...>>;
+
+    template <typename Start, typename... R>
+    class completion_awaiter
+    {
+    public:
+        explicit completion_awaiter(Start start) : start(std::move(start))
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            handle = h;
+
+            start([this](std::error_code ec, auto&&... values)
+            {
+                result.emplace(ec, std::forward<decltype(values)>(values)...);
+                handle.resume();
+            });
+        }
+
+        awaitable_result_t<R...> await_resume()
+        {
+            return std::move(*result);
+        }
+
+        Start start;
+        std::coroutine_handle<> handle;
+
+        std::optional<awaitable_result_t<R...>> result;
+    };
+
+    template <typename Op, typename Start, typename... R>
+    class operation_awaiter : private operation_base
+    {
+    public:
+        explicit operation_awaiter(Start start) : start(std::move(start))
+        {
+        }
+
+        operation_awaiter(operation_awaiter&& other) : start(std::move(other.start))
+        {
+            assert(!other.constructed);
+        }
+
+        operation_awaiter& operator=(operation_awaiter&&) = delete;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            handle = h;
+            execute_ = &operation_awaiter::on_release;
+
+            auto make = [this](auto&&... args) -> Op&
+            {
+                auto& op = this->op.construct(std::forward<decltype(args)>(args)...);
+
+                op.stop.completion = this;
+                constructed = true;
+
+                return op;
+            };
+
+            start(make, [this](std::error_code ec, auto&&... values)
+            {
+                result.emplace(ec, std::forward<decltype(values)>(values)...);
+            });
+        }
+
+        static void on_release(operation_base* op) noexcept
+        {
+            static_cast<operation_awaiter*>(op)->handle.resume();
+        }
+
+        awaitable_result_t<R...> await_resume()
+        {
+            return std::move(*result);
+        }
+
+        ~operation_awaiter()
+        {
+            if (constructed)
+                op.destruct();
+        }
+
+        Start start;
+        std::coroutine_handle<> handle;
+
+        bool constructed = false;
+        manual_lifetime<Op> op;
+
+        std::optional<awaitable_result_t<R...>> result;
+    };
+
+    template <typename Op, typename... R, typename F, typename Start>
+    decltype(auto) launch_operation(F&& f, Start start)
+    {
+        if constexpr(is_awaitable_v<F>)
+            return operation_awaiter<Op, Start, R...>(std::move(start));
+        else if constexpr(is_deferred_v<F>)
+            return start;
+        else
+        {
+            auto make = [](io_uring_context& context, auto&&... args) -> Op&
+            {
+                return *make_operation<Op>(context, std::forward<decltype(args)>(args)...);
+            };
+
+            start(make, std::forward<F>(f));
+        }
+    }
+
+    inline constexpr std::size_t frame_header_size = alignof(std::max_align_t);
+
+    inline void* allocate_frame(std::size_t size)
+    {
+        auto context = current_thread_context;
+        void* block = context != nullptr ? context->allocate_operation(size + frame_header_size) : ::operator new(size + frame_header_size);
+
+        *static_cast<io_uring_context**>(block) = context;
+
+        return static_cast<char*>(block) + frame_header_size;
+    }
+
+    inline void deallocate_frame(void* p, std::size_t size) noexcept
+    {
+        auto block = static_cast<char*>(p) - frame_header_size;
+        auto context = *reinterpret_cast<io_uring_context**>(block);
+
+        if (context != nullptr)
+            context->deallocate_operation(block, size + frame_header_size);
+        else
+            ::operator delete(block);
+    }
+
+    template <typename T = void>
+    class task;
+
+    template <typename T>
+    struct task_promise_base
+    {
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            template <typename P>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+            {
+                return h.promise().continuation;
+            }
+
+            void await_resume() noexcept
+            {
+            }
+        };
+
+        static void* operator new(std::size_t size)
+        {
+            return allocate_frame(size);
+        }
+
+        static void operator delete(void* p, std::size_t size) noexcept
+        {
+            deallocate_frame(p, size);
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        final_awaiter final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void unhandled_exception() noexcept
+        {
+            exception = std::current_exception();
+        }
+
+        std::coroutine_handle<> continuation = std::noop_coroutine();
+        std::exception_ptr exception;
+    };
+
+    template <typename T>
+    struct task_promise : task_promise_base<T>
+    {
+        task<T> get_return_object() noexcept;
+
+        template <typename U>
+        void return_value(U&& u)
+        {
+            value.emplace(std::forward<U>(u));
+        }
+
+        T result()
+        {
+            if (this->exception)
+                std::rethrow_exception(this->exception);
+
+            return std::move(*value);
+        }
+
+        std::optional<T> value;
+    };
+
+    template <>
+    struct task_promise<void> : task_promise_base<void>
+    {
+        task<void> get_return_object() noexcept;
+
+        void return_void() noexcept
+        {
+        }
+
+        void result()
+        {
+            if (this->exception)
+                std::rethrow_exception(this->exception);
+        }
+    };
+
+    template <typename T>
+    class task
+    {
+    public:
+        using promise_type = task_promise<T>;
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        explicit task(handle_type handle) noexcept : handle(handle)
+        {
+        }
+
+        task(task&& other) noexcept : handle(std::exchange(other.handle, nullptr))
+        {
+        }
+
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle)
+                    handle.destroy();
+
+                handle = std::exchange(other.handle, nullptr);
+            }
+
+            return *this;
+        }
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept
+        {
+            handle.promise().continuation = h;
+
+            return handle;
+        }
+
+        T await_resume()
+        {
+            return handle.promise().result();
+        }
+
+        ~task()
+        {
+            if (handle)
+                handle.destroy();
+        }
+
+    private:
+        handle_type handle;
+    };
+
+    template <typename T>
+    task<T> task_promise<T>::get_return_object() noexcept
+    {
+        return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+    }
+
+    inline task<void> task_promise<void>::get_return_object() noexcept
+    {
+        return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+    }
+
+    struct schedule_awaiter : private operation_base
+    {
+        explicit schedule_awaiter(io_uring_context& context) noexcept : context(context)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> h) noexcept
+        {
+            handle = h;
+            execute_ = &schedule_awaiter::on_schedule_complete;
+
+            context.schedule_impl(this);
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<schedule_awaiter*>(op)->handle.resume();
+        }
+
+        void await_resume() noexcept
+        {
+        }
+
+        io_uring_context& context;
+        std::coroutine_handle<> handle;
+    };
+
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+
+    template <typename F>
+    detached_task spawn_detached(io_uring_context& context, task<void> t, F f)
+    {
+        co_await schedule_awaiter(context);
+        std::exception_ptr e;
+
+        try
+        {
+            co_await std::move(t);
+        }
+        catch (...)
+        {
+            e = std::current_exception();
+        }
+
+        f(e);
+    }
+
+    template <typename F>
+    void spawn(io_uring_context& context, task<void> t, F&& f)
+    {
+        spawn_detached(context, std::move(t), std::forward<F>(f));
+    }
+
+    inline void spawn(io_uring_context& context, task<void> t)
+    {
+        spawn(context, std::move(t), [](std::exception_ptr e)
+        {
+            if (e)
+                std::terminate();
+        });
+    }
+}
+
+#endif
@@ -11,6 +11,7 @@
 #define IO_URING_BASE_HPP
 
 #include <atomic>
+#include <system_error>
 #include <linux/io_uring.h>
 #include <monotonic_clock.hpp>
 
@@ -20,6 +21,9 @@ namespace unp
     using time_point = monotonic_clock::time_point;
 
     static constexpr __u64 remote_queue_event_user_data = 0;
+    static constexpr __u64 remote_queue_message_user_data = 1;
+
+    static constexpr std::uintptr_t ring_message_tag = 1;
 
     struct __kernel_timespec
     {
@@ -27,6 +31,57 @@ namespace unp
         long long tv_nsec;
     };
 
+    struct deadline
+    {
+        deadline(const time_point& duetime) noexcept : duetime(duetime)
+        {
+        }
+
+        template <typename Rep, typename Ratio>
+        deadline(const std::chrono::duration<Rep, Ratio>& d) noexcept : duetime(monotonic_clock::now() + d)
+        {
+        }
+
+        time_point duetime;
+    };
+
+    struct deadline_timeout
+    {
+        void set(const deadline& d) noexcept
+        {
+            time_.tv_sec = d.duetime.seconds_part();
+            time_.tv_nsec = d.duetime.nanoseconds_part();
+
+            armed = true;
+        }
+
+        const __kernel_timespec* get() const noexcept
+        {
+            return armed ? &time_ : nullptr;
+        }
+
+        std::error_code error(int result) const noexcept
+        {
+            if (armed && result == -ECANCELED)
+                return std::make_error_code(std::errc::timed_out);
+
+            return std::error_code(-result, std::system_category());
+        }
+
+        bool armed = false;
+        __kernel_timespec time_;
+    };
+
+    inline deadline_timeout make_timeout(const deadline* d) noexcept
+    {
+        deadline_timeout timeout;
+
+        if (d != nullptr)
+            timeout.set(*d);
+
+        return timeout;
+    }
+
     struct operation_base
     {
         operation_base() noexcept
@@ -41,6 +96,30 @@ namespace unp
     struct completion_base : operation_base
     {
         int result;
+        std::uint32_t flags;
+    };
+
+    struct completion_event : operation_base
+    {
+        completion_event() noexcept
+        {
+            execute_ = &completion_event::dispatch;
+        }
+
+        static void dispatch(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<completion_event*>(op);
+
+            self.target->result = self.result;
+            self.target->flags = self.flags;
+
+            self.target->execute_(self.target);
+        }
+
+        completion_base* target;
+
+        int result;
+        std::uint32_t flags;
     };
 
     struct stop_operation : operation_base
@@ -71,8 +150,10 @@ namespace unp
         time_point duetime;
         bool cancelable;
 
-        timer_operation* next;
-        timer_operation* prev;
+        timer_operation* parent = nullptr;
+        timer_operation* left = nullptr;
+
+        timer_operation* right = nullptr;
 
         static constexpr std::uint32_t timer_elapsed_flag = 1;
         static constexpr std::uint32_t cancel_pending_flag = 2;
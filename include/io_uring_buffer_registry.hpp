@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_BUFFER_REGISTRY_HPP
+#define IO_URING_BUFFER_REGISTRY_HPP
+
+#include <span>
+#include <vector>
+#include <sys/uio.h>
+#include <sys/mman.h>
+
+namespace unp
+{
+    struct fixed_buffer
+    {
+        std::byte* data() const noexcept
+        {
+            return data_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        fixed_buffer first(std::size_t n) const noexcept
+        {
+            assert(n <= size_);
+
+            return {data_, n, index};
+        }
+
+        fixed_buffer subspan(std::size_t offset, std::size_t n) const noexcept
+        {
+            assert(offset + n <= size_);
+
+            return {data_ + offset, n, index};
+        }
+
+        operator std::span<std::byte>() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        operator std::span<const std::byte>() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+
+        int index = -1;
+    };
+
+    class buffer_registry
+    {
+    public:
+        static constexpr std::size_t huge_page_size = 2 << 20;
+
+        explicit buffer_registry(io_uring_context& context, unsigned count, std::size_t size, bool huge_pages = true) :
+        context(context), buffer_size(size)
+        {
+            auto length = count * size;
+
+            if (huge_pages)
+                length = (length + huge_page_size - 1) & ~(huge_page_size - 1);
+
+            void* ptr = MAP_FAILED;
+            constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+
+            if (huge_pages)
+                ptr = mmap(0, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+
+            if (ptr == MAP_FAILED)
+            {
+                ptr = mmap(0, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+
+                if (ptr == MAP_FAILED)
+                {
+                    int error_code = errno;
+                    throw(std::system_error(error_code, std::system_category()));
+                }
+
+                if (huge_pages)
+                    madvise(ptr, length, MADV_HUGEPAGE);
+            }
+
+            region = mmap_region(ptr, length);
+            auto* base = static_cast<std::byte*>(ptr);
+
+            for (unsigned i = 0; i < count; ++i)
+            {
+                 iovecs.push_back({base + i * size, size});
+                 free_buffers.push_back(count - i - 1);
+            }
+
+            if (io_uring_register(context.ring_fd.get(), IORING_REGISTER_BUFFERS, iovecs.data(), count) < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+        }
+
+        buffer_registry(const buffer_registry&) = delete;
+        buffer_registry& operator=(const buffer_registry&) = delete;
+
+        fixed_buffer operator[](unsigned i) const noexcept
+        {
+            assert(i < iovecs.size());
+
+            return {static_cast<std::byte*>(iovecs[i].iov_base), buffer_size, static_cast<int>(i)};
+        }
+
+        bool empty() const noexcept
+        {
+            return free_buffers.empty();
+        }
+
+        fixed_buffer acquire() noexcept
+        {
+            if (free_buffers.empty())
+                return {};
+
+            auto i = free_buffers.back();
+            free_buffers.pop_back();
+
+            return (*this)[i];
+        }
+
+        void release(const fixed_buffer& buffer) noexcept
+        {
+            assert(buffer.index >= 0 && static_cast<std::size_t>(buffer.index) < iovecs.size());
+            free_buffers.push_back(buffer.index);
+        }
+
+        std::size_t size() const noexcept
+        {
+            return iovecs.size();
+        }
+
+        ~buffer_registry()
+        {
+            io_uring_register(context.ring_fd.get(), IORING_UNREGISTER_BUFFERS, nullptr, 0);
+        }
+
+    private:
+        io_uring_context& context;
+        std::size_t buffer_size;
+
+        mmap_region region;
+        std::vector<iovec> iovecs;
+
+        std::vector<unsigned> free_buffers;
+    };
+}
+
+#endif
@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_BUFFER_RING_HPP
+#define IO_URING_BUFFER_RING_HPP
+
+#include <span>
+#include <atomic>
+#include <sys/mman.h>
+
+namespace unp
+{
+    struct received_buffer
+    {
+        std::byte* data() const noexcept
+        {
+            return data_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        operator std::span<std::byte>() const noexcept
+        {
+            return {data_, size_};
+        }
+
+        std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+
+        unsigned short id = 0;
+    };
+
+    class buffer_ring
+    {
+    public:
+        explicit buffer_ring(io_uring_context& context, unsigned short group, unsigned entries, std::size_t buffer_size) :
+        context(context), group_(group), entries(entries), buffer_size(buffer_size)
+        {
+            assert(entries > 0 && entries <= 32768 && (entries & (entries - 1)) == 0);
+
+            ring_mmap = map(entries * sizeof(io_uring_buf));
+            buffers_mmap = map(entries * buffer_size);
+
+            ring = static_cast<io_uring_buf*>(ring_mmap.data());
+            buffers = static_cast<std::byte*>(buffers_mmap.data());
+
+            io_uring_buf_reg reg;
+            std::memset(&reg, 0, sizeof(reg));
+
+            reg.ring_addr = reinterpret_cast<std::uintptr_t>(ring);
+            reg.ring_entries = entries;
+
+            reg.bgid = group;
+
+            if (io_uring_register(context.ring_fd.get(), IORING_REGISTER_PBUF_RING, &reg, 1) < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+
+            for (unsigned i = 0; i < entries; ++i)
+                 add(i);
+
+            publish();
+        }
+
+        static mmap_region map(std::size_t length)
+        {
+            auto ptr = mmap(0, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+
+            if (ptr == MAP_FAILED)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+
+            return mmap_region(ptr, length);
+        }
+
+        buffer_ring(const buffer_ring&) = delete;
+        buffer_ring& operator=(const buffer_ring&) = delete;
+
+        unsigned short group() const noexcept
+        {
+            return group_;
+        }
+
+        received_buffer get(unsigned short id, std::size_t length) const noexcept
+        {
+            assert(id < entries && length <= buffer_size);
+
+            return {buffers + id * buffer_size, length, id};
+        }
+
+        void release(const received_buffer& buffer) noexcept
+        {
+            add(buffer.id);
+            publish();
+        }
+
+        void recycle(unsigned short id) noexcept
+        {
+            add(id);
+            publish();
+        }
+
+        ~buffer_ring()
+        {
+            io_uring_buf_reg reg;
+            std::memset(&reg, 0, sizeof(reg));
+
+            reg.bgid = group_;
+            io_uring_register(context.ring_fd.get(), IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        }
+
+    private:
+        void add(unsigned short id) noexcept
+        {
+            auto& buf = ring[tail & (entries - 1)];
+
+            buf.addr = reinterpret_cast<std::uintptr_t>(buffers + id * buffer_size);
+            buf.len = buffer_size;
+
+            buf.bid = id;
+            ++tail;
+        }
+
+        void publish() noexcept
+        {
+            std::atomic_ref<__u16>(ring[0].resv).store(tail, std::memory_order_release);
+        }
+
+        io_uring_context& context;
+        unsigned short group_;
+
+        unsigned entries;
+        std::size_t buffer_size;
+
+        mmap_region ring_mmap;
+        mmap_region buffers_mmap;
+
+        io_uring_buf* ring;
+        std::byte* buffers;
+
+        __u16 tail = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_CANCEL_HPP
+#define IO_URING_CANCEL_HPP
+
+namespace unp
+{
+    class stop_cancel : private operation_base
+    {
+    public:
+        using release_fn = void(completion_base*) noexcept;
+        using cancel_fn = bool(completion_base*) noexcept;
+
+        struct stop_handler
+        {
+            void operator()() const noexcept
+            {
+                self->request_cancel();
+            }
+
+            stop_cancel* self;
+        };
+
+        void request_cancel() noexcept
+        {
+            refs.fetch_add(1, std::memory_order_relaxed);
+
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &stop_cancel::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_io();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<stop_cancel*>(op)->start_io();
+        }
+
+        void start_io() noexcept
+        {
+            assert(context.is_running_on_io_thread());
+
+            if (!(cancel_ != nullptr ? cancel_(target) : context.submit_cancel(target)))
+            {
+                execute_ = &stop_cancel::on_schedule_complete;
+                context.schedule_pending_io(this);
+            }
+            else
+                release();
+        }
+
+        explicit stop_cancel(io_uring_context& context, completion_base* target, release_fn* release_ = nullptr) noexcept :
+        context(context), target(target), release_(release_)
+        {
+        }
+
+        void arm(inplace_stop_token stop_token) noexcept
+        {
+            token = stop_token;
+            refs.store(1, std::memory_order_relaxed);
+
+            if (token.stop_possible())
+                callback.emplace(token, stop_handler{this});
+        }
+
+        void disarm() noexcept
+        {
+            callback.reset();
+        }
+
+        void release() noexcept
+        {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (completion != nullptr)
+                completion->execute_(completion);
+            else if (release_ != nullptr)
+                release_(target);
+        }
+
+        bool stop_requested() const noexcept
+        {
+            return token.stop_requested();
+        }
+
+        std::error_code error(int result, const deadline_timeout& timeout = {}) const noexcept
+        {
+            if (result == -ECANCELED && stop_requested())
+                return std::make_error_code(std::errc::operation_canceled);
+
+            return timeout.error(result);
+        }
+
+        io_uring_context& context;
+        completion_base* target;
+
+        release_fn* release_;
+        cancel_fn* cancel_ = nullptr;
+
+        operation_base* completion = nullptr;
+
+        inplace_stop_token token;
+
+        std::atomic<int> refs = 1;
+        std::optional<inplace_stop_callback<stop_handler>> callback;
+    };
+}
+
+#endif
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_CHAIN_HPP
+#define IO_URING_CHAIN_HPP
+
+#include <span>
+#include <vector>
+#include <sys/socket.h>
+
+namespace unp
+{
+    class chain : private operation_base
+    {
+    public:
+        struct link : completion_base
+        {
+            chain* owner;
+            std::size_t index;
+
+            bool hard = false;
+            io_uring_sqe sqe;
+        };
+
+        void start() noexcept
+        {
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &chain::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_io();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<chain*>(op)->start_io();
+        }
+
+        void start_io() noexcept
+        {
+            assert(context.is_running_on_io_thread());
+
+            if (links.empty())
+                return receiver(std::error_code(), std::span<const int>());
+
+            if (links.size() > context.sq_entry_count)
+            {
+                results.assign(links.size(), -EINVAL);
+
+                return finish();
+            }
+
+            if (stop.stop_requested())
+            {
+                results.assign(links.size(), -ECANCELED);
+
+                return finish();
+            }
+
+            auto fill = [this](io_uring_sqe& sqe, std::uint32_t i) noexcept
+            {
+                auto& l = links[i];
+                std::memcpy(&sqe, &l.sqe, sizeof(sqe));
+
+                if (i + 1 < links.size())
+                    sqe.flags |= l.hard ? IOSQE_IO_HARDLINK : IOSQE_IO_LINK;
+
+                sqe.user_data = reinterpret_cast<std::uintptr_t>(static_cast<completion_base*>(&l));
+                l.execute_ = &chain::on_link_complete;
+            };
+
+            if (!context.submit_io_group(links.size(), fill))
+            {
+                execute_ = &chain::on_schedule_complete;
+                context.schedule_pending_io(this);
+            }
+        }
+
+        static void on_link_complete(operation_base* op) noexcept
+        {
+            auto& l = *static_cast<link*>(op);
+            auto& self = *l.owner;
+
+            self.results[l.index] = l.result;
+
+            if (--self.remaining == 0)
+                self.finish();
+            else if (l.result >= 0 && self.stop.stop_requested())
+                self.stop.request_cancel();
+        }
+
+        static bool submit_cancel(completion_base* op) noexcept
+        {
+            auto& self = *static_cast<link*>(op)->owner;
+
+            if (self.remaining == 0)
+                return true;
+
+            return self.context.submit_cancel(&self.links[self.links.size() - self.remaining]);
+        }
+
+        void finish() noexcept
+        {
+            stop.disarm();
+
+            execute_ = &chain::on_finish;
+            stop.completion = this;
+
+            stop.release();
+        }
+
+        static void on_finish(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<chain*>(op);
+            std::error_code ec;
+
+            for (auto result : self.results)
+            {
+                 if (result == -ECANCELED)
+                     ec = std::make_error_code(std::errc::operation_canceled);
+                 else if (result < 0)
+                 {
+                     ec = std::error_code(-result, std::system_category());
+
+                     break;
+                 }
+            }
+
+            self.receiver(ec, std::span<const int>(self.results));
+        }
+
+        explicit chain(io_uring_context& context) noexcept : context(context), stop(context, nullptr)
+        {
+            stop.cancel_ = &chain::submit_cancel;
+        }
+
+        chain(const chain&) = delete;
+        chain& operator=(const chain&) = delete;
+
+        template <typename Stream, typename Buffer>
+        chain& read(Stream& stream, offset_t offset, const Buffer& buffer)
+        {
+            std::span<std::byte> data = buffer;
+            auto& sqe = add(stream, std::is_same_v<Buffer, fixed_buffer> ? IORING_OP_READ_FIXED : IORING_OP_READ);
+
+            sqe.addr = reinterpret_cast<std::uintptr_t>(data.data());
+            sqe.len = data.size();
+
+            sqe.off = offset;
+
+            if constexpr(std::is_same_v<Buffer, fixed_buffer>)
+                sqe.buf_index = buffer.index;
+
+            return *this;
+        }
+
+        template <typename Stream, typename Buffer>
+        chain& write(Stream& stream, offset_t offset, const Buffer& buffer)
+        {
+            std::span<const std::byte> data = buffer;
+            auto& sqe = add(stream, std::is_same_v<Buffer, fixed_buffer> ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE);
+
+            sqe.addr = reinterpret_cast<std::uintptr_t>(data.data());
+            sqe.len = data.size();
+
+            sqe.off = offset;
+
+            if constexpr(std::is_same_v<Buffer, fixed_buffer>)
+                sqe.buf_index = buffer.index;
+
+            return *this;
+        }
+
+        template <typename Stream, typename Buffer>
+        chain& send(Stream& stream, const Buffer& buffer)
+        {
+            std::span<const std::byte> data = buffer;
+            auto& sqe = add(stream, IORING_OP_SEND);
+
+            sqe.addr = reinterpret_cast<std::uintptr_t>(data.data());
+            sqe.len = data.size();
+
+            sqe.msg_flags = MSG_WAITALL;
+
+            return *this;
+        }
+
+        template <typename Stream, typename Endpoint>
+        chain& connect(Stream& stream, const Endpoint& endpoint)
+        {
+            auto& sqe = add(stream, IORING_OP_CONNECT);
+
+            sqe.addr = reinterpret_cast<std::uintptr_t>(endpoint.data());
+            sqe.off = endpoint.size();
+
+            return *this;
+        }
+
+        template <typename Stream>
+        chain& fsync(Stream& stream, bool data_only = false)
+        {
+            auto& sqe = add(stream, IORING_OP_FSYNC);
+            sqe.fsync_flags = data_only ? IORING_FSYNC_DATASYNC : 0;
+
+            return *this;
+        }
+
+        chain& hardlink() noexcept
+        {
+            assert(!links.empty());
+            links.back().hard = true;
+
+            return *this;
+        }
+
+        void clear() noexcept
+        {
+            links.clear();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return links.size();
+        }
+
+        template <typename F>
+        void async_submit(F&& f)
+        {
+            async_submit(inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_submit(inplace_stop_token token, F&& f)
+        {
+            receiver = std::forward<F>(f);
+
+            remaining = links.size();
+            results.assign(links.size(), 0);
+
+            if (!links.empty())
+            {
+                stop.target = &links.front();
+                stop.arm(token);
+            }
+
+            start();
+        }
+
+    private:
+        template <typename Stream>
+        io_uring_sqe& add(Stream& stream, io_uring_op opcode)
+        {
+            auto& l = links.emplace_back();
+
+            l.owner = this;
+            l.index = links.size() - 1;
+
+            std::memset(&l.sqe, 0, sizeof(l.sqe));
+
+            l.sqe.opcode = opcode;
+            l.sqe.fd = stream.get_handle();
+
+            l.sqe.flags = stream.get_sqe_flags();
+
+            return l.sqe;
+        }
+
+        io_uring_context& context;
+
+        std::size_t remaining = 0;
+        std::vector<link> links;
+
+        std::vector<int> results;
+        stop_cancel stop;
+
+        unique_function<void(std::error_code, std::span<const int>)> receiver;
+    };
+}
+
+#endif
@@ -35,11 +35,21 @@ namespace unp
         {
             assert(context.is_running_on_io_thread());
 
+            if (stop.stop_requested())
+            {
+                result = -ECANCELED;
+
+                return on_connect(this);
+            }
+
             auto fill = [this](io_uring_sqe& sqe) noexcept
             {
                 sqe.opcode = IORING_OP_CONNECT;
                 sqe.fd = fd_;
 
+                if (direct)
+                    sqe.flags = IOSQE_FIXED_FILE;
+
                 sqe.off = endpoint.size();
                 sqe.addr = reinterpret_cast<std::uintptr_t>((void*)(endpoint.data()));
 
@@ -47,7 +57,7 @@ namespace unp
                 execute_ = &connector::on_connect;
             };
 
-            if (!context.submit_io(fill))
+            if (!context.submit_io(fill, timeout.get()))
             {
                 execute_ = &connector::on_schedule_complete;
                 context.schedule_pending_io(this);
@@ -57,37 +67,68 @@ namespace unp
         static void on_connect(operation_base* op) noexcept
         {
             auto& self = *static_cast<connector*>(op);
+            self.stop.disarm();
 
             if (self.result >= 0)
                 self.receiver(std::error_code(), self.fd_);
             else
-                self.receiver(std::error_code(-self.result, std::system_category()), self.fd_);
+                self.receiver(self.stop.error(self.result, self.timeout), self.fd_);
+
+            self.stop.release();
         }
 
-        explicit connector(io_uring_context& context) noexcept : context(context)
+        static void on_release(completion_base* op) noexcept
+        {
+            destroy_operation(static_cast<connector*>(op));
+        }
+
+        explicit connector(io_uring_context& context, bool direct = false) noexcept : context(context), direct(direct),
+        stop(context, this, &connector::on_release)
         {
         }
 
         template <typename F>
         void async_connect(const unp::ip::tcp::endpoint& ep, F&& f)
+        {
+            async_connect(ep, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_connect(const unp::ip::tcp::endpoint& ep, inplace_stop_token token, F&& f)
         {
             endpoint = ep;
+            stop.arm(token);
 
-            async_socket(context, endpoint.protocol().family(), SOCK_STREAM, IPPROTO_TCP,
-            [this, f](std::error_code ec, int fd)
+            auto on_socket = [this, f = std::forward<F>(f)](std::error_code ec, int fd) mutable
             {
                 if (!ec)
                 {
-                    open_socket(fd);
-                    do_connect(f);
+                    if (direct)
+                        fd_ = fd;
+                    else
+                        open_socket(fd);
+
+                    do_connect(std::move(f));
+                }
+                else
+                {
+                    receiver = std::move(f);
+                    result = -ec.value();
+
+                    on_connect(this);
                 }
-            });
+            };
+
+            if (direct)
+                async_socket_direct(context, endpoint.protocol().family(), SOCK_STREAM, IPPROTO_TCP, std::move(on_socket));
+            else
+                async_socket(context, endpoint.protocol().family(), SOCK_STREAM, IPPROTO_TCP, std::move(on_socket));
         }
 
         template <typename F>
         void do_connect(F&& f)
         {
-            receiver = f;
+            receiver = std::forward<F>(f);
             start();
         }
 
@@ -108,11 +149,17 @@ namespace unp
         int fd_ = -1;
         io_uring_context& context;
 
+        bool direct;
+
         unp::ip::tcp::endpoint endpoint;
-        std::function<void(std::error_code, int)> receiver;
+        unique_function<void(std::error_code, int)> receiver;
+
+        deadline_timeout timeout;
+        stop_cancel stop;
     };
 
-    inline constexpr connect_impl<connector> async_connect {};
+    inline constexpr connect_impl<connector, 0> async_connect {};
+    inline constexpr connect_impl<connector, 1> async_connect_direct {};
 }
 
 #endif
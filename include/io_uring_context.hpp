@@ -12,13 +12,16 @@
 
 #include <cstring>
 #include <cassert>
+#include <vector>
 #include <signal.h>
+#include <optional>
 #include <functional>
 #include <arpa/inet.h>
 #include <sys/eventfd.h>
 #include <mmap_region.hpp>
 #include <scope_guard.hpp>
 #include <intrusive_heap.hpp>
+#include <operation_pool.hpp>
 #include <io_uring_buffer.hpp>
 #include <io_uring_syscall.hpp>
 #include <safe_file_descriptor.hpp>
@@ -26,13 +29,61 @@
 
 namespace unp
 {
+    struct context_options
+    {
+        unsigned sq_entries = 256;
+        unsigned cq_entries = 0;
+
+        bool coop_taskrun = false;
+        bool taskrun_flag = false;
+
+        bool single_issuer = false;
+        bool defer_taskrun = false;
+
+        bool sqpoll = false;
+        int sq_thread_cpu = -1;
+
+        unsigned sq_thread_idle = 0;
+
+        unsigned registered_files = 0;
+        unsigned direct_files = 0;
+
+        unsigned setup_flags() const noexcept
+        {
+            unsigned flags = 0;
+
+            if (cq_entries > 0)
+                flags |= IORING_SETUP_CQSIZE;
+
+            if (coop_taskrun || (taskrun_flag && !defer_taskrun))
+                flags |= IORING_SETUP_COOP_TASKRUN;
+
+            if (taskrun_flag)
+                flags |= IORING_SETUP_TASKRUN_FLAG;
+
+            if (single_issuer || defer_taskrun)
+                flags |= IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_R_DISABLED;
+
+            if (defer_taskrun)
+                flags |= IORING_SETUP_DEFER_TASKRUN;
+
+            if (sqpoll)
+                flags |= IORING_SETUP_SQPOLL;
+
+            if (sqpoll && sq_thread_cpu >= 0)
+                flags |= IORING_SETUP_SQ_AFF;
+
+            return flags;
+        }
+    };
+
     class io_uring_context
     {
     public:
         static constexpr int map_prot = PROT_READ | PROT_WRITE;
         static constexpr int map_flag = MAP_SHARED | MAP_POPULATE;
 
-        io_uring_context()
+        explicit io_uring_context(const context_options& options = {}) : options(options)
         {
             init_params();
 
@@ -41,12 +92,21 @@ namespace unp
 
             init_sqe();
             init_event();
+
+            init_files();
         }
 
         void init_params()
         {
             std::memset(&params, 0, sizeof(params));
-            int fd = io_uring_setup(256, &params);
+
+            params.flags = options.setup_flags();
+            params.cq_entries = options.cq_entries;
+
+            params.sq_thread_cpu = options.sq_thread_cpu;
+            params.sq_thread_idle = options.sq_thread_idle;
+
+            int fd = io_uring_setup(options.sq_entries, &params);
 
             if (fd < 0)
                 throw(std::system_error(-fd, std::system_category()));
@@ -79,6 +139,11 @@ namespace unp
 
             cq_entries = reinterpret_cast<io_uring_cqe*>(cq_block + params.cq_off.cqes);
             cq_overflow = reinterpret_cast<std::atomic<unsigned>*>(cq_block + params.cq_off.overflow);
+
+            cq_nodrop = (params.features & IORING_FEAT_NODROP) != 0;
+            cq_overflow_count = cq_overflow->load(std::memory_order_relaxed);
+
+            completion_events.resize(cq_entry_count);
         }
 
         void init_sq()
@@ -138,6 +203,111 @@ namespace unp
             remote_queue_event_fd = safe_file_descriptor(fd);
         }
 
+        void init_files()
+        {
+            const unsigned count = options.registered_files + options.direct_files;
+
+            if (count == 0)
+                return;
+
+            io_uring_rsrc_register files;
+            std::memset(&files, 0, sizeof(files));
+
+            files.nr = count;
+            files.flags = IORING_RSRC_REGISTER_SPARSE;
+
+            if (io_uring_register(ring_fd.get(), IORING_REGISTER_FILES2, &files, sizeof(files)) < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+
+            io_uring_file_index_range range;
+            std::memset(&range, 0, sizeof(range));
+
+            range.off = options.registered_files;
+            range.len = options.direct_files;
+
+            if (io_uring_register(ring_fd.get(), IORING_REGISTER_FILE_ALLOC_RANGE, &range, 0) < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+
+            for (unsigned i = options.registered_files; i > 0; --i)
+                 free_file_slots.push_back(i - 1);
+        }
+
+        int register_file(int fd)
+        {
+            if (free_file_slots.empty())
+                throw(std::system_error(ENFILE, std::system_category()));
+
+            const unsigned index = free_file_slots.back();
+
+            if (update_file(index, fd) < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+
+            free_file_slots.pop_back();
+
+            return index;
+        }
+
+        int try_register_file(int fd) noexcept
+        {
+            if (free_file_slots.empty())
+                return -1;
+
+            const unsigned index = free_file_slots.back();
+
+            if (update_file(index, fd) < 0)
+                return -1;
+
+            free_file_slots.pop_back();
+
+            return index;
+        }
+
+        void unregister_file(int index) noexcept
+        {
+            [[maybe_unused]] int result = update_file(index, -1);
+            assert(result >= 0);
+
+            if (static_cast<unsigned>(index) < options.registered_files)
+                free_file_slots.push_back(index);
+        }
+
+        int update_file(unsigned index, int fd) noexcept
+        {
+            io_uring_files_update update;
+
+            update.offset = index;
+            update.resv = 0;
+
+            update.fds = reinterpret_cast<std::uintptr_t>(&fd);
+
+            return io_uring_register(ring_fd.get(), IORING_REGISTER_FILES_UPDATE, &update, 1);
+        }
+
+        void enable_ring()
+        {
+            if ((params.flags & IORING_SETUP_R_DISABLED) == 0 || ring_enabled)
+                return;
+
+            int result = io_uring_register(ring_fd.get(), IORING_REGISTER_ENABLE_RINGS, nullptr, 0);
+
+            if (result < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+
+            ring_enabled = true;
+        }
+
         template <typename T>
         void run(T t)
         {
@@ -149,14 +319,35 @@ namespace unp
         }
 
         using operation_queue = intrusive_queue<operation_base, &operation_base::next>;
-        using timer_heap = intrusive_heap<timer_operation, &timer_operation::next,
-                           &timer_operation::prev, time_point, &timer_operation::duetime>;
+        using timer_heap = intrusive_heap<timer_operation, &timer_operation::parent, &timer_operation::left,
+                           &timer_operation::right, time_point, &timer_operation::duetime>;
 
         bool is_running_on_io_thread() const noexcept
         {
             return this == current_thread_context;
         }
 
+        std::uint32_t load() const noexcept
+        {
+            return published_load.load(std::memory_order_relaxed);
+        }
+
+        void* allocate_operation(std::size_t size)
+        {
+            if (is_running_on_io_thread())
+                return pool.allocate_local(size);
+
+            return pool.allocate_remote(size);
+        }
+
+        void deallocate_operation(void* p, std::size_t size) noexcept
+        {
+            if (is_running_on_io_thread())
+                pool.deallocate_local(p, size);
+            else
+                pool.deallocate_remote(p, size);
+        }
+
         void run_impl(const bool& should_stop)
         {
             auto* old_context = std::exchange(current_thread_context, this);
@@ -166,9 +357,12 @@ namespace unp
                 std::exchange(current_thread_context, old_context);
             };
 
+            enable_ring();
+
             while (true)
             {
                 execute_pending_local();
+                published_load.store(pending_operation_count(), std::memory_order_relaxed);
 
                 if (should_stop)
                     break;
@@ -184,10 +378,17 @@ namespace unp
                 while (!pending_io_queue.empty() && can_submit_io())
                 {
                     auto* item = pending_io_queue.pop_front();
+                    submitting_pending_io = item;
+
                     item->execute_(item);
+
+                    if (std::exchange(submitting_pending_io, nullptr) == nullptr)
+                        break;
                 }
 
-                if (local_queue.empty() || sq_unflushed_count > 0)
+                const bool must_get_events = has_pending_task_work() || has_overflowed_completions();
+
+                if (local_queue.empty() || sq_unflushed_count > 0 || must_get_events)
                 {
                     const bool is_idle = sq_unflushed_count == 0 && local_queue.empty();
 
@@ -197,17 +398,36 @@ namespace unp
                     unsigned flags = 0;
                     int min_completion_count = 0;
 
-                    if (is_idle && (remote_queue_read_submitted || pending_operation_count() == cq_entry_count))
+                    if (is_idle && (remote_queue_read_submitted || !has_completion_capacity()))
                     {
                         min_completion_count = 1;
                         flags = IORING_ENTER_GETEVENTS;
                     }
 
+                    if (options.defer_taskrun || must_get_events)
+                        flags |= IORING_ENTER_GETEVENTS;
+
+                    if (options.sqpoll)
+                    {
+                        cq_pending_count += std::exchange(sq_unflushed_count, 0);
+                        flags |= sq_poll_flags();
+
+                        if ((flags & IORING_ENTER_SQ_WAIT) != 0)
+                            min_completion_count = 0;
+
+                        if (flags == 0)
+                            continue;
+                    }
+
                     int result = io_uring_enter(ring_fd.get(), sq_unflushed_count, min_completion_count, flags, nullptr);
 
                     if (result < 0)
                     {
                         int error_code = errno;
+
+                        if (error_code == EBUSY)
+                            continue;
+
                         throw(std::system_error(error_code, std::system_category()));
                     }
 
@@ -248,7 +468,12 @@ namespace unp
         void schedule_pending_io(operation_base* op) noexcept
         {
             assert(is_running_on_io_thread());
-            pending_io_queue.push_back(op);
+
+            if (op != submitting_pending_io)
+                return pending_io_queue.push_back(op);
+
+            submitting_pending_io = nullptr;
+            pending_io_queue.push_front(op);
         }
 
         void reschedule_pending_io(operation_base* op) noexcept
@@ -257,6 +482,12 @@ namespace unp
             pending_io_queue.push_front(op);
         }
 
+        bool remove_pending_io(operation_base* op) noexcept
+        {
+            assert(is_running_on_io_thread());
+            return pending_io_queue.remove(op);
+        }
+
         void insert_timer(timer_operation* op) noexcept
         {
             assert(is_running_on_io_thread());
@@ -285,6 +516,17 @@ namespace unp
 
         void acquire_completion_queue_items() noexcept
         {
+            if (options.sqpoll)
+                cq_pending_count += std::exchange(sq_unflushed_count, 0);
+
+            const auto overflow_count = cq_overflow->load(std::memory_order_relaxed);
+
+            if (overflow_count != cq_overflow_count)
+            {
+                dropped_completions += overflow_count - cq_overflow_count;
+                cq_overflow_count = overflow_count;
+            }
+
             std::uint32_t head = cq_head->load(std::memory_order_relaxed);
             std::uint32_t tail = cq_tail->load(std::memory_order_acquire);
 
@@ -294,12 +536,26 @@ namespace unp
                 const auto count = tail - head;
 
                 assert(count <= cq_entry_count);
+
+                std::uint32_t finished_count = 0;
+                std::uint32_t event_count = 0;
+
                 operation_queue completion_queue;
 
                 for (std::uint32_t i = 0; i < count; ++i)
                 {
                      auto& cqe = cq_entries[(head + i) & mask];
 
+                     if (cqe.user_data == remote_queue_message_user_data)
+                     {
+                         remote_queue_read_submitted = false;
+
+                         continue;
+                     }
+
+                     if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+                         ++finished_count;
+
                      if (cqe.user_data == remote_queue_event_user_data)
                      {
                          if (cqe.res < 0)
@@ -312,10 +568,19 @@ namespace unp
                              std::terminate();
 
                          assert(bytes_read == sizeof(buffer));
+
+                         remote_queue_poll_armed = false;
                          remote_queue_read_submitted = false;
 
                          continue;
                      }
+                     else if ((cqe.user_data & ring_message_tag) != 0)
+                     {
+                         if (cqe.res < 0)
+                             reinterpret_cast<io_uring_context*>(cqe.user_data & ~ring_message_tag)->signal_remote_queue_event();
+
+                         continue;
+                     }
                      else if (cqe.user_data == timer_user_data())
                      {
                          assert(active_timer_count > 0);
@@ -329,19 +594,24 @@ namespace unp
 
                          continue;
                      }
-                     else if (cqe.user_data == remove_timer_user_data())
+                     else if (cqe.user_data == remove_timer_user_data() || cqe.user_data == cancel_user_data() || cqe.user_data == link_timeout_user_data())
                          continue;
 
-                     auto& completion_state = *reinterpret_cast<completion_base*>(static_cast<std::uintptr_t>(cqe.user_data));
+                     auto& event = completion_events[event_count++];
 
-                     completion_state.result = cqe.res;
-                     completion_queue.push_back(&completion_state);
+                     event.target = reinterpret_cast<completion_base*>(static_cast<std::uintptr_t>(cqe.user_data));
+                     event.result = cqe.res;
+
+                     event.flags = cqe.flags;
+                     completion_queue.push_back(&event);
                 }
 
                 schedule_local(std::move(completion_queue));
 
                 cq_head->store(tail, std::memory_order_release);
-                cq_pending_count -= count;
+
+                assert(finished_count <= cq_pending_count);
+                cq_pending_count -= finished_count;
             }
         }
 
@@ -355,6 +625,20 @@ namespace unp
 
         bool register_remote_queue_notification() noexcept
         {
+            if (remote_queue_poll_armed)
+            {
+                auto queued_items = remote_queue_.mark_inactive_or_dequeue_all();
+
+                if (!queued_items.empty())
+                {
+                    schedule_local(std::move(queued_items));
+
+                    return false;
+                }
+
+                return true;
+            }
+
             auto fill = [this](io_uring_sqe& sqe) noexcept
             {
                 auto queued_items = remote_queue_.mark_inactive_or_dequeue_all();
@@ -376,12 +660,42 @@ namespace unp
             };
 
             if (submit_io(fill))
+            {
+                remote_queue_poll_armed = true;
+
                 return true;
+            }
 
             return false;
         }
 
         void signal_remote_queue()
+        {
+            auto* sender = current_thread_context;
+
+            if (sender != nullptr && sender != this && sender->submit_ring_message(*this))
+                return;
+
+            signal_remote_queue_event();
+        }
+
+        bool submit_ring_message(io_uring_context& target) noexcept
+        {
+            auto fill = [&](io_uring_sqe& sqe) noexcept
+            {
+                sqe.opcode = IORING_OP_MSG_RING;
+                sqe.fd = target.ring_fd.get();
+
+                sqe.addr = IORING_MSG_DATA;
+                sqe.off = remote_queue_message_user_data;
+
+                sqe.user_data = reinterpret_cast<std::uintptr_t>(&target) | ring_message_tag;
+            };
+
+            return submit_io(fill);
+        }
+
+        void signal_remote_queue_event()
         {
             const __u64 value = 1;
             ssize_t bytes_written = write(remote_queue_event_fd.get(), &value, sizeof(value));
@@ -506,12 +820,82 @@ namespace unp
             return submit_io(fill);
         }
 
+        bool submit_cancel(const completion_base* op) noexcept
+        {
+            auto fill = [&](io_uring_sqe& sqe) noexcept
+            {
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+
+                sqe.addr = reinterpret_cast<std::uintptr_t>(op);
+                sqe.user_data = cancel_user_data();
+            };
+
+            return submit_io(fill);
+        }
+
+        template <typename F>
+        bool submit_io(F fill, const __kernel_timespec* timeout) noexcept
+        {
+            if (timeout == nullptr)
+                return submit_io(fill);
+
+            auto linked_fill = [&](io_uring_sqe& sqe, std::uint32_t i) noexcept
+            {
+                if (i == 0)
+                {
+                    fill(sqe);
+                    sqe.flags |= IOSQE_IO_LINK;
+
+                    return;
+                }
+
+                sqe.opcode = IORING_OP_LINK_TIMEOUT;
+
+                sqe.addr = reinterpret_cast<std::uintptr_t>(timeout);
+                sqe.len = 1;
+
+                sqe.timeout_flags = IORING_TIMEOUT_ABS;
+                sqe.user_data = link_timeout_user_data();
+            };
+
+            return submit_io_group(2, linked_fill);
+        }
+
+        template <typename F>
+        bool submit_io_group(std::uint32_t count, F fill) noexcept
+        {
+            assert(is_running_on_io_thread());
+            assert(count > 0 && count <= sq_entry_count);
+
+            if (!has_submission_capacity(count))
+                return false;
+
+            const auto tail = sq_tail->load(std::memory_order_relaxed);
+
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                 const auto index = (tail + i) & sq_mask;
+                 auto& sqe = sq_entries[index];
+
+                 static_assert(noexcept(fill(sqe, i)));
+                 std::memset(&sqe, 0, sizeof(sqe));
+
+                 fill(sqe, i);
+                 sq_index_array[index] = index;
+            }
+
+            sq_tail->store(tail + count, std::memory_order_release);
+            sq_unflushed_count += count;
+
+            return true;
+        }
+
         template <typename F>
         bool submit_io(F fill) noexcept
         {
             assert(is_running_on_io_thread());
 
-            if (pending_operation_count() < cq_entry_count)
+            if (has_completion_capacity())
             {
                 const auto head = sq_head->load(std::memory_order_acquire);
                 const auto tail = sq_tail->load(std::memory_order_relaxed);
@@ -544,6 +928,50 @@ namespace unp
             return false;
         }
 
+        std::uint32_t sq_ring_count() const noexcept
+        {
+            return sq_tail->load(std::memory_order_relaxed) - sq_head->load(std::memory_order_acquire);
+        }
+
+        unsigned sq_poll_flags() const noexcept
+        {
+            unsigned flags = 0;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if ((sq_flags->load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP) != 0 && sq_ring_count() > 0)
+                flags |= IORING_ENTER_SQ_WAKEUP;
+
+            if (!pending_io_queue.empty() && sq_ring_count() > 0)
+                flags |= IORING_ENTER_SQ_WAIT;
+
+            return flags;
+        }
+
+        bool has_submission_capacity(std::uint32_t count) const noexcept
+        {
+            return sq_entry_count - sq_ring_count() >= count && (cq_nodrop || pending_operation_count() + count <= cq_entry_count);
+        }
+
+        bool has_completion_capacity() const noexcept
+        {
+            return cq_nodrop || pending_operation_count() < cq_entry_count;
+        }
+
+        std::uint64_t dropped_completion_count() const noexcept
+        {
+            return dropped_completions;
+        }
+
+        bool has_overflowed_completions() const noexcept
+        {
+            return (sq_flags->load(std::memory_order_relaxed) & IORING_SQ_CQ_OVERFLOW) != 0;
+        }
+
+        bool has_pending_task_work() const noexcept
+        {
+            return options.taskrun_flag && (sq_flags->load(std::memory_order_relaxed) & IORING_SQ_TASKRUN) != 0;
+        }
+
         std::uint32_t pending_operation_count() const noexcept
         {
             return cq_pending_count + sq_unflushed_count;
@@ -551,7 +979,7 @@ namespace unp
 
         bool can_submit_io() const noexcept
         {
-            return sq_unflushed_count < sq_entry_count && pending_operation_count() < cq_entry_count;
+            return has_submission_capacity(1);
         }
 
         std::uintptr_t timer_user_data() const
@@ -564,6 +992,16 @@ namespace unp
             return reinterpret_cast<std::uintptr_t>(&current_duetime);
         }
 
+        std::uintptr_t cancel_user_data() const
+        {
+            return reinterpret_cast<std::uintptr_t>(&pending_io_queue);
+        }
+
+        std::uintptr_t link_timeout_user_data() const
+        {
+            return reinterpret_cast<std::uintptr_t>(&options);
+        }
+
         ~io_uring_context()
         {
         }
@@ -586,6 +1024,11 @@ namespace unp
         io_uring_cqe* cq_entries;
         const std::atomic<unsigned>* cq_overflow;
 
+        bool cq_nodrop;
+        unsigned cq_overflow_count;
+
+        std::uint64_t dropped_completions = 0;
+
         std::atomic<unsigned>* cq_head;
         const std::atomic<unsigned>* cq_tail;
 
@@ -598,8 +1041,16 @@ namespace unp
         mmap_region sqe_mmap;
         io_uring_params params;
 
+        context_options options;
+        bool ring_enabled = false;
+
+        std::vector<unsigned> free_file_slots;
+
         operation_queue local_queue;
         operation_queue pending_io_queue;
+        operation_base* submitting_pending_io = nullptr;
+
+        std::vector<completion_event> completion_events;
 
         timer_heap timers;
         std::optional<time_point> current_duetime;
@@ -608,13 +1059,33 @@ namespace unp
         std::uint32_t cq_pending_count = 0;
 
         bool timers_are_dirty = false;
+        bool remote_queue_poll_armed = false;
         bool remote_queue_read_submitted = false;
 
         std::uint32_t active_timer_count = 0;
 
         __kernel_timespec time_;
+        std::atomic<std::uint32_t> published_load = 0;
+
+        operation_pool pool;
+
         atomic_intrusive_queue<operation_base, &operation_base::next> remote_queue_;
     };
+
+    template <typename T, typename... Args>
+    T* make_operation(io_uring_context& context, Args&&... args)
+    {
+        return ::new (context.allocate_operation(sizeof(T))) T(context, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void destroy_operation(T* op) noexcept
+    {
+        auto& context = op->context;
+
+        op->~T();
+        context.deallocate_operation(op, sizeof(T));
+    }
 }
 
 #endif
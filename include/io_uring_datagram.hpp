@@ -14,6 +14,30 @@
 
 namespace unp
 {
+    struct datagram_segments
+    {
+        std::size_t size() const noexcept
+        {
+            if (segment_size == 0)
+                return data_.empty() ? 0 : 1;
+
+            return (data_.size() + segment_size - 1) / segment_size;
+        }
+
+        std::span<std::byte> operator[](std::size_t i) const noexcept
+        {
+            if (segment_size == 0)
+                return data_;
+
+            auto offset = i * segment_size;
+
+            return data_.subspan(offset, std::min(segment_size, data_.size() - offset));
+        }
+
+        std::span<std::byte> data_;
+        std::size_t segment_size = 0;
+    };
+
     class datagram_socket
     {
     public:
@@ -48,9 +72,10 @@ namespace unp
         template <typename T, typename Buffer, typename F>
         void async_io(const Buffer& buffer, unp::ip::udp::endpoint& endpoint, F&& f)
         {
-            auto p = std::make_shared<T>(get_context(), get_fd(), 0, buffer, endpoint);
+            auto p = make_operation<T>(get_context(), get_handle(), 0, buffer, endpoint);
+            p->sqe_flags = get_sqe_flags();
 
-            p->async_io([p, f](std::error_code ec, std::size_t bytes_transferred)
+            p->async_io([f = std::forward<F>(f)](std::error_code ec, std::size_t bytes_transferred) mutable
             {
                 f(ec, bytes_transferred);
             });
@@ -68,11 +93,114 @@ namespace unp
             async_io<send_to_type>(buffer, endpoint, std::forward<F>(f));      
         }
 
+        template <typename Buffer, typename F>
+        void async_send_batch_to(const Buffer& buffer, std::uint16_t segment_size, unp::ip::udp::endpoint& endpoint, F&& f)
+        {
+            auto p = make_operation<send_to_type>(get_context(), get_handle(), 0, buffer, endpoint);
+
+            p->sqe_flags = get_sqe_flags();
+            p->segment_size = segment_size;
+
+            p->async_io([f = std::forward<F>(f)](std::error_code ec, std::size_t bytes_transferred) mutable
+            {
+                f(ec, bytes_transferred);
+            });
+        }
+
+        template <typename F>
+        void async_receive_batch_from(std::span<std::byte> buffer, unp::ip::udp::endpoint& endpoint, F&& f)
+        {
+            auto p = make_operation<receive_from_type>(get_context(), get_handle(), 0, buffer, endpoint);
+
+            p->sqe_flags = get_sqe_flags();
+            p->gro = true;
+
+            p->async_io([p, f = std::forward<F>(f), buffer](std::error_code ec, std::size_t bytes_transferred) mutable
+            {
+                f(ec, datagram_segments{buffer.first(ec ? 0 : bytes_transferred), static_cast<std::size_t>(p->segment_size)});
+            });
+        }
+
+        void set_gro(bool value)
+        {
+            int val = value;
+
+            if (setsockopt(get_fd(), SOL_UDP, UDP_GRO, &val, sizeof(val)) < 0)
+            {
+                int error_code = errno;
+                throw(std::system_error(error_code, std::system_category()));
+            }
+        }
+
+        template <typename Buffer, typename F, typename R>
+        void async_send_to_zc(const Buffer& buffer, const unp::ip::udp::endpoint& endpoint, F&& f, R&& r)
+        {
+            async_send_to_zc(buffer, endpoint, inplace_stop_token(), std::forward<F>(f), std::forward<R>(r));
+        }
+
+        template <typename Buffer, typename F, typename R>
+        void async_send_to_zc(const Buffer& buffer, const unp::ip::udp::endpoint& endpoint, inplace_stop_token token, F&& f, R&& r)
+        {
+            using operation_t = std::conditional_t<std::is_same_v<Buffer, fixed_buffer>, send_zc_operation, send_msg_zc_operation>;
+
+            auto p = make_operation<operation_t>(get_context(), get_handle(), buffer);
+            p->sqe_flags = get_sqe_flags();
+
+            if constexpr(std::is_same_v<Buffer, fixed_buffer>)
+                p->buf_index = buffer.index;
+
+            p->name = endpoint.data();
+            p->namelen = endpoint.size();
+
+            p->async_send(token, [f = std::forward<F>(f)](std::error_code ec, std::size_t bytes_transferred) mutable
+            {
+                f(ec, bytes_transferred);
+            }, std::forward<R>(r));
+        }
+
+        template <typename F>
+        void async_receive_from_stream(buffer_ring& ring, F&& f)
+        {
+            async_receive_from_stream(ring, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_receive_from_stream(buffer_ring& ring, inplace_stop_token token, F&& f)
+        {
+            auto p = make_operation<receive_from_operation>(get_context(), get_handle(), ring);
+            p->sqe_flags = get_sqe_flags();
+
+            p->async_receive_stream(token, [p, f = std::forward<F>(f)](std::error_code ec, received_buffer buffer) mutable
+            {
+                f(ec, buffer, p->endpoint);
+            });
+        }
+
         int get_fd()
         {
             return fd_.get();
         }
 
+        int get_index()
+        {
+            return index_;
+        }
+
+        bool is_fixed()
+        {
+            return index_ >= 0;
+        }
+
+        int get_handle()
+        {
+            return is_fixed() ? index_ : get_fd();
+        }
+
+        std::uint8_t get_sqe_flags()
+        {
+            return is_fixed() ? IOSQE_FIXED_FILE : 0;
+        }
+
         io_uring_context& get_context()
         {
             return context;
@@ -88,8 +216,21 @@ namespace unp
             fd_.reset(fd);
         }
 
+        void register_file()
+        {
+            release_index();
+            index_ = context.register_file(get_fd());
+        }
+
+        void release_index() noexcept
+        {
+            if (is_fixed())
+                context.unregister_file(std::exchange(index_, -1));
+        }
+
         void close()
         {
+            release_index();
             fd_.close();
         }
 
@@ -98,8 +239,15 @@ namespace unp
             ::shutdown(get_fd(), type);
         }
 
+        ~datagram_socket()
+        {
+            release_index();
+        }
+
         io_uring_context& context;
         safe_file_descriptor fd_;
+
+        int index_ = -1;
     };
 }
 
@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_DATAGRAM_BATCH_HPP
+#define IO_URING_DATAGRAM_BATCH_HPP
+
+#include <span>
+#include <vector>
+#include <sys/socket.h>
+
+namespace unp
+{
+    struct datagram_result
+    {
+        std::error_code ec;
+        std::size_t bytes = 0;
+
+        unp::ip::udp::endpoint endpoint;
+    };
+
+    template <io_uring_op opcode>
+    class datagram_batch : private operation_base
+    {
+    public:
+        using buffer_t = std::conditional_t<opcode == IORING_OP_RECVMSG, std::span<std::byte>, std::span<const std::byte>>;
+
+        struct entry : completion_base
+        {
+            datagram_batch* batch;
+            std::size_t index;
+
+            msghdr msg;
+            iovec buff;
+        };
+
+        void start() noexcept
+        {
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &datagram_batch::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_io();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<datagram_batch*>(op)->start_io();
+        }
+
+        void start_io() noexcept
+        {
+            assert(context.is_running_on_io_thread());
+
+            if (entries.empty())
+                return receiver(std::span<const datagram_result>());
+
+            if (stop.stop_requested())
+            {
+                for (auto i = submitted; i < entries.size(); ++i)
+                     results[i].ec = std::make_error_code(std::errc::operation_canceled);
+
+                remaining -= entries.size() - submitted;
+                submitted = entries.size();
+
+                if (remaining == 0)
+                    finish();
+
+                return;
+            }
+
+            while (submitted < entries.size())
+            {
+                auto& e = entries[submitted];
+
+                auto fill = [&](io_uring_sqe& sqe) noexcept
+                {
+                    sqe.opcode = opcode;
+                    sqe.fd = fd;
+
+                    sqe.flags = sqe_flags;
+                    sqe.addr = reinterpret_cast<std::uintptr_t>(&e.msg);
+
+                    sqe.user_data = reinterpret_cast<std::uintptr_t>(static_cast<completion_base*>(&e));
+                    e.execute_ = &datagram_batch::on_entry_complete;
+                };
+
+                if (!context.submit_io(fill))
+                {
+                    execute_ = &datagram_batch::on_schedule_complete;
+                    context.schedule_pending_io(this);
+
+                    return;
+                }
+
+                ++submitted;
+            }
+        }
+
+        static void on_entry_complete(operation_base* op) noexcept
+        {
+            auto& e = *static_cast<entry*>(op);
+            auto& self = *e.batch;
+
+            auto& r = self.results[e.index];
+
+            if (e.result < 0)
+                r.ec = self.stop.error(e.result);
+            else
+                r.bytes = e.result;
+
+            if (--self.remaining == 0)
+                self.finish();
+        }
+
+        static bool submit_cancel(completion_base* op) noexcept
+        {
+            auto& self = *static_cast<entry*>(op)->batch;
+
+            for (; self.cancelled < self.submitted; ++self.cancelled)
+            {
+                 if (!self.context.submit_cancel(&self.entries[self.cancelled]))
+                     return false;
+            }
+
+            return true;
+        }
+
+        void finish() noexcept
+        {
+            stop.disarm();
+
+            execute_ = &datagram_batch::on_finish;
+            stop.completion = this;
+
+            stop.release();
+        }
+
+        static void on_finish(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<datagram_batch*>(op);
+            self.receiver(std::span<const datagram_result>(self.results));
+        }
+
+        explicit datagram_batch(datagram_socket& socket, std::size_t capacity) : context(socket.get_context()), socket(socket), capacity(capacity), stop(context, nullptr)
+        {
+            stop.cancel_ = &datagram_batch::submit_cancel;
+
+            entries.reserve(capacity);
+            results.reserve(capacity);
+        }
+
+        datagram_batch(const datagram_batch&) = delete;
+        datagram_batch& operator=(const datagram_batch&) = delete;
+
+        bool push(buffer_t buffer, const unp::ip::udp::endpoint& endpoint = {}) noexcept
+        {
+            if (entries.size() == capacity)
+                return false;
+
+            auto& r = results.emplace_back();
+            r.endpoint = endpoint;
+
+            auto& e = entries.emplace_back();
+
+            e.batch = this;
+            e.index = entries.size() - 1;
+
+            e.buff.iov_base = (void*)buffer.data();
+            e.buff.iov_len = buffer.size();
+
+            std::memset(&e.msg, 0, sizeof(e.msg));
+
+            e.msg.msg_name = r.endpoint.data();
+            e.msg.msg_namelen = opcode == IORING_OP_RECVMSG ? r.endpoint.capacity() : r.endpoint.size();
+
+            e.msg.msg_iov = &e.buff;
+            e.msg.msg_iovlen = 1;
+
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            entries.clear();
+            results.clear();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return entries.size();
+        }
+
+        template <typename F>
+        void async_submit(F&& f)
+        {
+            async_submit(inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_submit(inplace_stop_token token, F&& f)
+        {
+            receiver = std::forward<F>(f);
+
+            fd = socket.get_handle();
+            sqe_flags = socket.get_sqe_flags();
+
+            submitted = 0;
+            cancelled = 0;
+
+            remaining = entries.size();
+
+            for (auto& r : results)
+            {
+                 r.ec.clear();
+                 r.bytes = 0;
+            }
+
+            if (!entries.empty())
+            {
+                stop.target = &entries.front();
+                stop.arm(token);
+            }
+
+            start();
+        }
+
+        io_uring_context& context;
+        datagram_socket& socket;
+
+        int fd = -1;
+        std::uint8_t sqe_flags = 0;
+
+        std::size_t capacity;
+        std::size_t submitted = 0;
+
+        std::size_t cancelled = 0;
+        std::size_t remaining = 0;
+
+        std::vector<entry> entries;
+        std::vector<datagram_result> results;
+
+        stop_cancel stop;
+        unique_function<void(std::span<const datagram_result>)> receiver;
+    };
+
+    using datagram_send_batch = datagram_batch<IORING_OP_SENDMSG>;
+    using datagram_receive_batch = datagram_batch<IORING_OP_RECVMSG>;
+}
+
+#endif
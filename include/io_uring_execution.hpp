@@ -0,0 +1,441 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_EXECUTION_HPP
+#define IO_URING_EXECUTION_HPP
+
+#include <tuple>
+#include <optional>
+
+namespace unp::execution
+{
+    template <typename Receiver>
+    inplace_stop_token get_stop_token(const Receiver& receiver) noexcept
+    {
+        if constexpr(requires { { receiver.get_stop_token() } -> std::convertible_to<inplace_stop_token>; })
+            return receiver.get_stop_token();
+        else
+            return inplace_stop_token();
+    }
+
+    template <typename Receiver, typename... V>
+    void complete(Receiver& receiver, std::error_code ec, V&&... values) noexcept
+    {
+        if (!ec)
+            receiver.set_value(std::forward<V>(values)...);
+        else if (ec == std::errc::operation_canceled && get_stop_token(receiver).stop_requested())
+            receiver.set_stopped();
+        else
+            receiver.set_error(ec);
+    }
+
+    inline std::error_code current_error_code() noexcept
+    {
+        try
+        {
+            throw;
+        }
+        catch (const std::system_error& e)
+        {
+            return e.code();
+        }
+        catch (const std::bad_alloc&)
+        {
+            return std::make_error_code(std::errc::not_enough_memory);
+        }
+        catch (...)
+        {
+            return std::make_error_code(std::errc::io_error);
+        }
+    }
+
+    template <typename Sender, typename Receiver>
+    auto connect(Sender&& sender, Receiver&& receiver)
+    {
+        return std::forward<Sender>(sender).connect(std::forward<Receiver>(receiver));
+    }
+
+    template <typename Operation>
+    void start(Operation& operation) noexcept
+    {
+        operation.start();
+    }
+
+    template <typename Op, typename Receiver, typename Start, typename... V>
+    class io_operation : private operation_base
+    {
+    public:
+        explicit io_operation(Receiver receiver, Start start) : receiver(std::move(receiver)), start_(std::move(start))
+        {
+        }
+
+        io_operation(const io_operation&) = delete;
+        io_operation& operator=(const io_operation&) = delete;
+
+        void start() noexcept
+        {
+            execute_ = &io_operation::on_release;
+
+            auto make = [this](auto&&... args) -> Op&
+            {
+                auto& op = this->op.construct(std::forward<decltype(args)>(args)...);
+
+                op.stop.completion = this;
+                constructed = true;
+
+                return op;
+            };
+
+            try
+            {
+                start_(make, [this](std::error_code ec, auto&&... values)
+                {
+                    result.emplace(ec, std::forward<decltype(values)>(values)...);
+                });
+            }
+            catch (...)
+            {
+                receiver.set_error(current_error_code());
+            }
+        }
+
+        static void on_release(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<io_operation*>(op);
+
+            std::apply([&](std::error_code ec, auto&... values)
+            {
+                complete(self.receiver, ec, std::move(values)...);
+            }, *self.result);
+        }
+
+        ~io_operation()
+        {
+            if (constructed)
+                op.destruct();
+        }
+
+        Receiver receiver;
+        Start start_;
+
+        bool constructed = false;
+        manual_lifetime<Op> op;
+
+        std::optional<std::tuple<std::error_code, V...>> result;
+    };
+
+    template <typename Op, typename Factory, typename... V>
+    class io_sender
+    {
+    public:
+        using value_types = std::tuple<V...>;
+
+        explicit io_sender(Factory factory) : factory(std::move(factory))
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            using start_t = std::invoke_result_t<const Factory&, inplace_stop_token>;
+            auto token = get_stop_token(receiver);
+
+            return io_operation<Op, std::decay_t<Receiver>, start_t, V...>(std::forward<Receiver>(receiver), factory(token));
+        }
+
+        Factory factory;
+    };
+
+    template <typename Op, typename... V, typename Factory>
+    auto make_io_sender(Factory factory)
+    {
+        return io_sender<Op, Factory, V...>(std::move(factory));
+    }
+
+    template <typename Receiver>
+    class schedule_operation : private operation_base
+    {
+    public:
+        explicit schedule_operation(io_uring_context& context, Receiver receiver) : context(context), receiver(std::move(receiver))
+        {
+        }
+
+        schedule_operation(const schedule_operation&) = delete;
+        schedule_operation& operator=(const schedule_operation&) = delete;
+
+        void start() noexcept
+        {
+            if (get_stop_token(receiver).stop_requested())
+                return receiver.set_stopped();
+
+            execute_ = &schedule_operation::on_schedule_complete;
+            context.schedule_impl(this);
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<schedule_operation*>(op);
+
+            if (get_stop_token(self.receiver).stop_requested())
+                self.receiver.set_stopped();
+            else
+                self.receiver.set_value();
+        }
+
+        io_uring_context& context;
+        Receiver receiver;
+    };
+
+    class schedule_sender
+    {
+    public:
+        using value_types = std::tuple<>;
+
+        explicit schedule_sender(io_uring_context& context) noexcept : context(context)
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            return schedule_operation<std::decay_t<Receiver>>(context, std::forward<Receiver>(receiver));
+        }
+
+        io_uring_context& context;
+    };
+
+    template <typename Receiver>
+    class wait_operation : private operation_base
+    {
+    public:
+        struct stop_handler
+        {
+            void operator()() const noexcept
+            {
+                self->timer.get().request_stop();
+            }
+
+            wait_operation* self;
+        };
+
+        explicit wait_operation(io_uring_context& context, const time_point& duetime, Receiver receiver) :
+        context(context), duetime(duetime), receiver(std::move(receiver))
+        {
+        }
+
+        wait_operation(const wait_operation&) = delete;
+        wait_operation& operator=(const wait_operation&) = delete;
+
+        void start() noexcept
+        {
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &wait_operation::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_local();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<wait_operation*>(op)->start_local();
+        }
+
+        void start_local() noexcept
+        {
+            auto token = get_stop_token(receiver);
+
+            if (token.stop_requested())
+                return receiver.set_stopped();
+
+            auto& t = timer.construct(context, duetime);
+            constructed = true;
+
+            t.completion = this;
+            execute_ = &wait_operation::on_release;
+
+            try
+            {
+                t.async_wait([this](std::error_code e)
+                {
+                    ec = e;
+                    timer.get().release();
+                });
+            }
+            catch (...)
+            {
+                return receiver.set_error(current_error_code());
+            }
+
+            if (token.stop_possible())
+                callback.emplace(token, stop_handler{this});
+        }
+
+        static void on_release(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<wait_operation*>(op);
+
+            self.callback.reset();
+            complete(self.receiver, self.ec);
+        }
+
+        ~wait_operation()
+        {
+            if (constructed)
+                timer.destruct();
+        }
+
+        io_uring_context& context;
+
+        time_point duetime;
+        Receiver receiver;
+
+        std::error_code ec;
+        bool constructed = false;
+
+        manual_lifetime<timer_impl> timer;
+        std::optional<inplace_stop_callback<stop_handler>> callback;
+    };
+
+    class wait_sender
+    {
+    public:
+        using value_types = std::tuple<>;
+
+        explicit wait_sender(io_uring_context& context, const time_point& duetime) noexcept : context(context), duetime(duetime)
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            return wait_operation<std::decay_t<Receiver>>(context, duetime, std::forward<Receiver>(receiver));
+        }
+
+        io_uring_context& context;
+        time_point duetime;
+    };
+
+    template <typename Receiver>
+    class accept_operation
+    {
+    public:
+        explicit accept_operation(acceptor& acc, Receiver receiver) : acc(acc), receiver(std::move(receiver))
+        {
+        }
+
+        accept_operation(const accept_operation&) = delete;
+        accept_operation& operator=(const accept_operation&) = delete;
+
+        void start() noexcept
+        {
+            try
+            {
+                acc.async_accept(get_stop_token(receiver), [this](std::error_code ec, acceptor::socket_t socket)
+                {
+                    complete(receiver, ec, std::move(socket));
+                });
+            }
+            catch (...)
+            {
+                receiver.set_error(current_error_code());
+            }
+        }
+
+        acceptor& acc;
+        Receiver receiver;
+    };
+
+    class accept_sender
+    {
+    public:
+        using value_types = std::tuple<acceptor::socket_t>;
+
+        explicit accept_sender(acceptor& acc) noexcept : acc(acc)
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            return accept_operation<std::decay_t<Receiver>>(acc, std::forward<Receiver>(receiver));
+        }
+
+        acceptor& acc;
+    };
+
+    inline schedule_sender schedule(io_uring_context& context) noexcept
+    {
+        return schedule_sender(context);
+    }
+
+    inline wait_sender schedule_at(io_uring_context& context, const time_point& duetime) noexcept
+    {
+        return wait_sender(context, duetime);
+    }
+
+    template <typename Rep, typename Ratio>
+    wait_sender schedule_after(io_uring_context& context, const std::chrono::duration<Rep, Ratio>& duration) noexcept
+    {
+        return wait_sender(context, monotonic_clock::now() + duration);
+    }
+
+    template <typename Stream, typename Buffer>
+    auto async_read(Stream& stream, const Buffer& buffer)
+    {
+        return make_io_sender<read_type, std::size_t>([&stream, buffer](inplace_stop_token token)
+        {
+            return unp::async_read(stream, buffer, token, deferred_start);
+        });
+    }
+
+    template <typename Stream, typename Buffer>
+    auto async_write(Stream& stream, const Buffer& buffer)
+    {
+        return make_io_sender<write_type, std::size_t>([&stream, buffer](inplace_stop_token token)
+        {
+            return unp::async_write(stream, buffer, token, deferred_start);
+        });
+    }
+
+    template <typename Stream, typename Buffer>
+    auto async_read_some(Stream& stream, const Buffer& buffer)
+    {
+        return make_io_sender<read_some_type, std::size_t>([&stream, buffer](inplace_stop_token token)
+        {
+            return unp::async_read_some(stream, buffer, token, deferred_start);
+        });
+    }
+
+    template <typename Stream, typename Buffer>
+    auto async_write_some(Stream& stream, const Buffer& buffer)
+    {
+        return make_io_sender<write_some_type, std::size_t>([&stream, buffer](inplace_stop_token token)
+        {
+            return unp::async_write_some(stream, buffer, token, deferred_start);
+        });
+    }
+
+    template <typename Stream, typename Endpoint>
+    auto async_connect(Stream& stream, const Endpoint& endpoint)
+    {
+        return make_io_sender<connector, int>([&stream, endpoint](inplace_stop_token token)
+        {
+            return unp::async_connect(stream, endpoint, token, deferred_start);
+        });
+    }
+
+    inline accept_sender async_accept(acceptor& acc) noexcept
+    {
+        return accept_sender(acc);
+    }
+}
+
+#endif
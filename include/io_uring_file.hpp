@@ -29,11 +29,35 @@ namespace unp
         {
         }
 
+        async_file(async_file&& other) noexcept : context(other.context), fd_(std::move(other.fd_)), index_(std::exchange(other.index_, -1))
+        {
+        }
+
         int get_fd()
         {
             return fd_.get();
         }
 
+        int get_index()
+        {
+            return index_;
+        }
+
+        bool is_fixed()
+        {
+            return index_ >= 0;
+        }
+
+        int get_handle()
+        {
+            return is_fixed() ? index_ : get_fd();
+        }
+
+        std::uint8_t get_sqe_flags()
+        {
+            return is_fixed() ? IOSQE_FIXED_FILE : 0;
+        }
+
         io_uring_context& get_context()
         {
             return context;
@@ -41,7 +65,7 @@ namespace unp
 
         bool is_open()
         {
-            return fd_.valid();
+            return fd_.valid() || is_fixed();
         }
 
         void reset(int fd)
@@ -49,18 +73,60 @@ namespace unp
             fd_.reset(fd);
         }
 
+        void reset_direct(int index)
+        {
+            release_index();
+            index_ = index;
+        }
+
+        void register_file()
+        {
+            release_index();
+            index_ = context.register_file(get_fd());
+        }
+
+        void release_index() noexcept
+        {
+            if (is_fixed())
+                context.unregister_file(std::exchange(index_, -1));
+        }
+
         void close()
         {
+            release_index();
             fd_.close();
         }
 
         void shutdown(shutdown_type type)
         {
-            ::shutdown(get_fd(), type);
+            if (fd_.valid() || !is_fixed())
+                ::shutdown(get_fd(), type);
+            else
+                async_shutdown(type, [](std::error_code){});
+        }
+
+        template <typename F>
+        void async_shutdown(shutdown_type type, F&& f)
+        {
+            async_shutdown(type, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_shutdown(shutdown_type type, inplace_stop_token token, F&& f)
+        {
+            auto p = make_operation<shutdown_operation>(context, get_handle(), get_sqe_flags(), type);
+            p->async_shutdown(token, std::forward<F>(f));
+        }
+
+        ~async_file()
+        {
+            release_index();
         }
 
         io_uring_context& context;
         safe_file_descriptor fd_;
+
+        int index_ = -1;
     };
 
     class file_base
@@ -18,92 +18,321 @@ namespace unp
         template <typename Stream, typename Buffer, typename F>
         requires B
         constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, F&& f) const
+        {
+            return io(stream, buffer, nullptr, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires B
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, const deadline& d, F&& f) const
+        {
+            return io(stream, buffer, &d, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires B
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, inplace_stop_token token, F&& f) const
+        {
+            return io(stream, buffer, nullptr, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires B
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, const deadline& d, inplace_stop_token token, F&& f) const
+        {
+            return io(stream, buffer, &d, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && !T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, offset_t offset, const Buffer& buffer, F&& f) const
+        {
+            return io_at(stream, offset, buffer, nullptr, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && !T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, offset_t offset, const Buffer& buffer, const deadline& d, F&& f) const
+        {
+            return io_at(stream, offset, buffer, &d, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && !T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, offset_t offset, const Buffer& buffer, inplace_stop_token token, F&& f) const
+        {
+            return io_at(stream, offset, buffer, nullptr, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && !T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, offset_t offset, const Buffer& buffer, const deadline& d, inplace_stop_token token, F&& f) const
+        {
+            return io_at(stream, offset, buffer, &d, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, unp::ip::udp::endpoint& endpoint, F&& f) const
+        {
+            return io_to(stream, buffer, endpoint, nullptr, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, unp::ip::udp::endpoint& endpoint, const deadline& d, F&& f) const
+        {
+            return io_to(stream, buffer, endpoint, &d, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, unp::ip::udp::endpoint& endpoint, inplace_stop_token token, F&& f) const
+        {
+            return io_to(stream, buffer, endpoint, nullptr, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        requires (!B && T::is_udp)
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, unp::ip::udp::endpoint& endpoint, const deadline& d, inplace_stop_token token, F&& f) const
+        {
+            return io_to(stream, buffer, endpoint, &d, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Buffer, typename F>
+        static decltype(auto) io(Stream& stream, const Buffer& buffer, const deadline* d, inplace_stop_token token, F&& f)
         {
             offset_t offset = 0;
-            constexpr auto seekable = requires { stream.offset; };
 
-            if constexpr(seekable)
+            if constexpr(is_seekable<Stream>)
                 offset = stream.offset;
 
-            auto p = std::make_shared<T>(stream.get_context(), stream.get_fd(), offset, buffer, seekable);
-
-            p->async_io([p, f, &stream](std::error_code ec, std::size_t bytes_transferred)
+            return launch_operation<T, std::size_t>(std::forward<F>(f), [&stream, buffer, offset, timeout = make_timeout(d), token](auto make, auto f)
             {
-                if (!ec)
+                auto& op = make(stream.get_context(), stream.get_handle(), offset, buffer, is_seekable<Stream>);
+                prepare(op, stream, buffer, timeout);
+
+                op.async_io(token, [f = std::move(f), &stream](std::error_code ec, std::size_t bytes_transferred) mutable
                 {
-                    if constexpr(seekable)
-                        stream.offset += bytes_transferred;
-                }
+                    if (!ec)
+                    {
+                        if constexpr(is_seekable<Stream>)
+                            stream.offset += bytes_transferred;
+                    }
 
-                f(ec, bytes_transferred);
+                    f(ec, bytes_transferred);
+                });
             });
         }
 
         template <typename Stream, typename Buffer, typename F>
-        requires (!B)
-        constexpr decltype(auto) operator()(Stream& stream, offset_t offset, const Buffer& buffer, F&& f) const
+        static decltype(auto) io_at(Stream& stream, offset_t offset, const Buffer& buffer, const deadline* d, inplace_stop_token token, F&& f)
         {
-            auto p = std::make_shared<T>(stream.get_context(), stream.get_fd(), offset, buffer, false);
+            return launch_operation<T, std::size_t>(std::forward<F>(f), [&stream, buffer, offset, timeout = make_timeout(d), token](auto make, auto f)
+            {
+                auto& op = make(stream.get_context(), stream.get_handle(), offset, buffer, false);
+                prepare(op, stream, buffer, timeout);
+
+                op.async_io(token, [f = std::move(f)](std::error_code ec, std::size_t bytes_transferred) mutable
+                {
+                    f(ec, bytes_transferred);
+                });
+            });
+        }
 
-            p->async_io([p, f](std::error_code ec, std::size_t bytes_transferred)
+        template <typename Stream, typename Buffer, typename F>
+        static decltype(auto) io_to(Stream& stream, const Buffer& buffer, unp::ip::udp::endpoint& endpoint, const deadline* d, inplace_stop_token token, F&& f)
+        {
+            return launch_operation<T, std::size_t>(std::forward<F>(f), [&stream, &endpoint, buffer, timeout = make_timeout(d), token](auto make, auto f)
             {
-                f(ec, bytes_transferred);
+                auto& op = make(stream.get_context(), stream.get_handle(), 0, buffer, endpoint);
+                prepare(op, stream, buffer, timeout);
+
+                op.async_io(token, [f = std::move(f)](std::error_code ec, std::size_t bytes_transferred) mutable
+                {
+                    f(ec, bytes_transferred);
+                });
             });
         }
 
-        template <typename Stream, typename Buffer, typename Endpoint, typename F>
-        requires (!B)
-        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, Endpoint& endpoint, F&& f) const
+        template <typename Stream>
+        static constexpr bool is_seekable = requires(Stream& stream) { stream.offset; };
+
+        template <typename Stream, typename Buffer>
+        static void prepare(T& op, Stream& stream, const Buffer& buffer, const deadline_timeout& timeout) noexcept
         {
-            auto p = std::make_shared<T>(stream.get_context(), stream.get_fd(), 0, buffer, endpoint);
+            op.sqe_flags = stream.get_sqe_flags();
+            op.timeout = timeout;
 
-            p->async_io([p, f](std::error_code ec, std::size_t bytes_transferred)
+            if constexpr(std::is_same_v<Buffer, fixed_buffer>)
+                op.buf_index = buffer.index;
+        }
+    };
+
+    template <typename T>
+    struct receive_impl
+    {
+        template <typename Stream, typename Ring, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, Ring& ring, F&& f) const
+        {
+            return receive(stream, ring, nullptr, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Ring, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, Ring& ring, const deadline& d, F&& f) const
+        {
+            return receive(stream, ring, &d, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Ring, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, Ring& ring, inplace_stop_token token, F&& f) const
+        {
+            return receive(stream, ring, nullptr, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Ring, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, Ring& ring, const deadline& d, inplace_stop_token token, F&& f) const
+        {
+            return receive(stream, ring, &d, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Ring, typename F>
+        static decltype(auto) receive(Stream& stream, Ring& ring, const deadline* d, inplace_stop_token token, F&& f)
+        {
+            return launch_operation<T, received_buffer>(std::forward<F>(f), [&stream, &ring, timeout = make_timeout(d), token](auto make, auto f)
             {
-                f(ec, bytes_transferred);
+                auto& op = make(stream.get_context(), stream.get_handle(), ring);
+
+                op.sqe_flags = stream.get_sqe_flags();
+                op.timeout = timeout;
+
+                op.async_receive(token, [f = std::move(f)](std::error_code ec, received_buffer buffer) mutable
+                {
+                    f(ec, buffer);
+                });
             });
         }
     };
 
+    template <typename T>
+    struct receive_stream_impl
+    {
+        template <typename Stream, typename Ring, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, Ring& ring, F&& f) const
+        {
+            return operator()(stream, ring, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Ring, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, Ring& ring, inplace_stop_token token, F&& f) const
+        {
+            auto p = make_operation<T>(stream.get_context(), stream.get_handle(), ring);
+            p->sqe_flags = stream.get_sqe_flags();
+
+            p->async_receive_stream(token, [f = std::forward<F>(f)](std::error_code ec, received_buffer buffer) mutable
+            {
+                f(ec, buffer);
+            });
+        }
+    };
+
+    template <typename T>
+    struct send_zc_impl
+    {
+        template <typename Stream, typename Buffer, typename F, typename R>
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, F&& f, R&& r) const
+        {
+            return operator()(stream, buffer, inplace_stop_token(), std::forward<F>(f), std::forward<R>(r));
+        }
+
+        template <typename Stream, typename Buffer, typename F, typename R>
+        constexpr decltype(auto) operator()(Stream& stream, const Buffer& buffer, inplace_stop_token token, F&& f, R&& r) const
+        {
+            auto p = make_operation<T>(stream.get_context(), stream.get_handle(), buffer);
+            p->sqe_flags = stream.get_sqe_flags();
+
+            if constexpr(std::is_same_v<Buffer, fixed_buffer>)
+                p->buf_index = buffer.index;
+
+            p->async_send(token, [f = std::forward<F>(f)](std::error_code ec, std::size_t bytes_transferred) mutable
+            {
+                f(ec, bytes_transferred);
+            }, std::forward<R>(r));
+        }
+    };
+
     template <typename T>
     struct post_impl
     {
         template <typename Context, typename F>
         constexpr decltype(auto) operator()(Context& context, F&& f) const
         {
-            auto p = std::make_shared<T>(context);
+            auto p = make_operation<T>(context);
 
-            p->async_post([p, f]
+            p->async_post([f = std::forward<F>(f)]() mutable
             {
                 f();
             });
         }
     };
 
-    template <typename T>
+    template <typename T, bool D>
     struct connect_impl
     {
         template <typename Stream, typename Endpoint, typename F>
         constexpr decltype(auto) operator()(Stream& stream, const Endpoint& endpoint, F&& f) const
         {
-            auto p = std::make_shared<T>(stream.get_context());
+            return connect(stream, endpoint, nullptr, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Endpoint, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, const Endpoint& endpoint, const deadline& d, F&& f) const
+        {
+            return connect(stream, endpoint, &d, inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Endpoint, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, const Endpoint& endpoint, inplace_stop_token token, F&& f) const
+        {
+            return connect(stream, endpoint, nullptr, token, std::forward<F>(f));
+        }
 
-            p->async_connect(endpoint, [&stream, p, f](std::error_code ec, int fd)
+        template <typename Stream, typename Endpoint, typename F>
+        constexpr decltype(auto) operator()(Stream& stream, const Endpoint& endpoint, const deadline& d, inplace_stop_token token, F&& f) const
+        {
+            return connect(stream, endpoint, &d, token, std::forward<F>(f));
+        }
+
+        template <typename Stream, typename Endpoint, typename F>
+        static decltype(auto) connect(Stream& stream, const Endpoint& endpoint, const deadline* d, inplace_stop_token token, F&& f)
+        {
+            return launch_operation<T, int>(std::forward<F>(f), [&stream, endpoint, timeout = make_timeout(d), token](auto make, auto f)
             {
-                stream.reset(fd);
-                f(ec, fd);
+                auto& op = make(stream.get_context(), D);
+                op.timeout = timeout;
+
+                op.async_connect(endpoint, token, [&stream, f = std::move(f)](std::error_code ec, int fd) mutable
+                {
+                    if constexpr(D)
+                        stream.reset_direct(fd);
+                    else
+                        stream.reset(fd);
+
+                    f(ec, fd);
+                });
             });
         }
     };
 
-    template <typename T>
+    template <typename T, bool D>
     struct socket_impl
     {
         template <typename Context, typename F>
         constexpr decltype(auto) operator()(Context& context, int domain, int type, int protocol, F&& f) const
         {
-            auto p = std::make_shared<T>(context, domain, type, protocol);
+            auto p = make_operation<T>(context, domain, type, protocol, D);
 
-            p->async_socket([p, f](std::error_code ec, int fd)
+            p->async_socket([f = std::forward<F>(f)](std::error_code ec, int fd) mutable
             {
                 f(ec, fd);
             });
@@ -122,8 +351,14 @@ namespace unp
     inline constexpr async_io<receive_from_type, 0> async_receive_from {};
     inline constexpr async_io<send_to_type, 0> async_send_to {};
 
+    inline constexpr send_zc_impl<send_zc_operation> async_write_zc {};
+
+    inline constexpr receive_impl<receive_operation> async_receive {};
+    inline constexpr receive_stream_impl<receive_operation> async_receive_stream {};
+
     inline constexpr post_impl<post_operation> post {};
-    inline constexpr socket_impl<socket_operation> async_socket {};
+    inline constexpr socket_impl<socket_operation, 0> async_socket {};
+    inline constexpr socket_impl<socket_operation, 1> async_socket_direct {};
 }
 
 #endif
@@ -24,6 +24,8 @@ namespace unp
         {
             auto& self = *static_cast<post_operation*>(op);
             self.receiver();
+
+            destroy_operation(&self);
         }
 
         explicit post_operation(io_uring_context& context) noexcept : context(context)
@@ -34,12 +36,12 @@ namespace unp
         template <typename F>
         void async_post(F&& f)
         {
-            receiver = f;
+            receiver = std::forward<F>(f);
             start();
         }
 
         io_uring_context& context;
-        std::function<void()> receiver; 
+        unique_function<void()> receiver;
     };
 }
 
@@ -10,6 +10,8 @@
 #ifndef IO_URING_READ_WRITE_HPP
 #define IO_URING_READ_WRITE_HPP
 
+#include <netinet/udp.h>
+
 namespace unp
 {
     template <typename T, io_uring_op opcode, bool B>
@@ -21,6 +23,8 @@ namespace unp
         static constexpr bool is_tcp = opcode == IORING_OP_READV || opcode == IORING_OP_WRITEV;
         static constexpr bool is_udp = opcode == IORING_OP_RECVMSG || opcode == IORING_OP_SENDMSG;
 
+        static constexpr auto fixed_opcode = opcode == IORING_OP_READV ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+
         using seekable_t = std::conditional_t<is_udp, unp::ip::udp::endpoint&, bool>;
 
         void start() noexcept
@@ -43,16 +47,35 @@ namespace unp
         {
             assert(context.is_running_on_io_thread());
 
+            if (stop.stop_requested())
+            {
+                result = -ECANCELED;
+
+                return on_io_complete(this);
+            }
+
             auto fill = [this](io_uring_sqe& sqe) noexcept
             {
                 sqe.opcode = opcode;
                 sqe.fd = fd;
 
+                sqe.flags = sqe_flags;
+
                 if constexpr(is_udp)
                 {
+                    init_control();
+
                     sqe.addr = reinterpret_cast<std::uintptr_t>(&msg);
                     sqe.msg_flags = 0;
                 }
+                else if (buf_index >= 0)
+                {
+                    sqe.opcode = fixed_opcode;
+                    sqe.addr = reinterpret_cast<std::uintptr_t>(buffer_.data());
+
+                    sqe.len = buffer_.size();
+                    sqe.buf_index = buf_index;
+                }
                 else
                 {
                     sqe.addr = reinterpret_cast<std::uintptr_t>(&buff);
@@ -65,7 +88,7 @@ namespace unp
                 execute_ = &rw_type::on_io_complete;
             };
 
-            if (!context.submit_io(fill))
+            if (!context.submit_io(fill, timeout.get()))
             {
                 execute_ = &rw_type::on_schedule_complete;
                 context.schedule_pending_io(this);
@@ -80,31 +103,48 @@ namespace unp
             {
                 self.bytes += self.result;
 
+                if constexpr(is_udp)
+                    self.parse_control();
+
                 if constexpr(is_tcp)
                     self.offset += self.seekable * self.result;
 
                 if ((B && (!self.bytes || self.bytes == self.size)) || !B)
                 {
                     if (!self.bytes)
-                        self.receiver(std::make_error_code(std::errc::no_message), self.bytes);
+                        self.finish(std::make_error_code(std::errc::no_message), self.bytes);
                     else
-                        self.receiver(std::error_code(), self.bytes);
+                        self.finish(std::error_code(), self.bytes);
                 }
                 else
                 {
-                    self.buffer_ = unp::advance(self.buffer_, self.bytes);
+                    self.buffer_ = unp::advance(self.buffer_, self.result);
 
                     self.init();
                     self.start();
                 }
             }
             else
-                self.receiver(std::error_code(-self.result, std::system_category()), self.result);
+                self.finish(self.stop.error(self.result, self.timeout), self.result);
+        }
+
+        void finish(std::error_code ec, int value) noexcept
+        {
+            stop.disarm();
+            receiver(ec, value);
+
+            stop.release();
+        }
+
+        static void on_release(completion_base* op) noexcept
+        {
+            destroy_operation(static_cast<rw_type*>(op));
         }
 
     public:
         explicit rw_type(io_uring_context& context, int fd, offset_t offset, buffer_t buffer, seekable_t seekable) noexcept :
-        context(context), fd(fd), offset(offset), buffer_(buffer), seekable(seekable), size(buffer.size())
+        context(context), fd(fd), offset(offset), buffer_(buffer), seekable(seekable), size(buffer.size()),
+        stop(context, this, &rw_type::on_release)
         {
             init();
         }
@@ -112,7 +152,15 @@ namespace unp
         template <typename F>
         void async_io(F&& f)
         {
-            receiver = f;
+            async_io(inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_io(inplace_stop_token token, F&& f)
+        {
+            receiver = std::forward<F>(f);
+            stop.arm(token);
+
             start();
         }
 
@@ -123,17 +171,64 @@ namespace unp
 
             if constexpr(is_udp)
             {
+                std::memset(&msg, 0, sizeof(msg));
+
                 msg.msg_name = seekable.data();
-                msg.msg_namelen = seekable.size();
+                msg.msg_namelen = opcode == IORING_OP_RECVMSG ? seekable.capacity() : seekable.size();
 
                 msg.msg_iov = &buff;
                 msg.msg_iovlen = 1;
             }
         }
 
+        void init_control() noexcept
+        {
+            msg.msg_control = nullptr;
+            msg.msg_controllen = 0;
+
+            if (opcode == IORING_OP_SENDMSG && segment_size > 0)
+            {
+                std::memset(control, 0, sizeof(control));
+
+                msg.msg_control = control;
+                msg.msg_controllen = CMSG_SPACE(sizeof(std::uint16_t));
+
+                auto cmsg = CMSG_FIRSTHDR(&msg);
+
+                cmsg->cmsg_level = SOL_UDP;
+                cmsg->cmsg_type = UDP_SEGMENT;
+
+                cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+                *reinterpret_cast<std::uint16_t*>(CMSG_DATA(cmsg)) = segment_size;
+            }
+            else if (opcode == IORING_OP_RECVMSG && gro)
+            {
+                msg.msg_control = control;
+                msg.msg_controllen = sizeof(control);
+            }
+        }
+
+        void parse_control() noexcept
+        {
+            if (opcode != IORING_OP_RECVMSG || !gro)
+                return;
+
+            segment_size = 0;
+
+            for (auto cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+            {
+                 if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO)
+                     std::memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+            }
+        }
+
         io_uring_context& context;
 
         int fd;
+        int buf_index = -1;
+
+        std::uint8_t sqe_flags = 0;
+
         offset_t offset;
 
         buffer_t buffer_;
@@ -145,7 +240,15 @@ namespace unp
         iovec buff;
         msghdr msg;
 
-        std::function<void(std::error_code, int)> receiver;
+        int segment_size = 0;
+        bool gro = false;
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+
+        deadline_timeout timeout;
+        stop_cancel stop;
+
+        unique_function<void(std::error_code, int)> receiver;
     };
 
     using read_type = rw_type<std::byte, IORING_OP_READV, 1>;
@@ -0,0 +1,193 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_RECEIVE_HPP
+#define IO_URING_RECEIVE_HPP
+
+namespace unp
+{
+    template <io_uring_op Opcode>
+    class receive_type : private completion_base
+    {
+    public:
+        void start() noexcept
+        {
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &receive_type::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_io();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<receive_type*>(op)->start_io();
+        }
+
+        void start_io() noexcept
+        {
+            assert(context.is_running_on_io_thread());
+
+            if (stop.stop_requested())
+            {
+                result = -ECANCELED;
+                flags = 0;
+
+                return multishot ? on_receive_stream(this) : on_receive(this);
+            }
+
+            auto fill = [this](io_uring_sqe& sqe) noexcept
+            {
+                sqe.opcode = Opcode;
+                sqe.fd = fd;
+
+                if constexpr(Opcode == IORING_OP_RECVMSG)
+                {
+                    std::memset(&msg, 0, sizeof(msg));
+                    msg.msg_namelen = endpoint.capacity();
+
+                    sqe.addr = reinterpret_cast<std::uintptr_t>(&msg);
+                }
+
+                sqe.flags = sqe_flags | IOSQE_BUFFER_SELECT;
+                sqe.buf_group = ring.group();
+
+                if (multishot)
+                    sqe.ioprio = IORING_RECV_MULTISHOT;
+
+                sqe.user_data = reinterpret_cast<std::uintptr_t>(static_cast<completion_base*>(this));
+                execute_ = multishot ? &receive_type::on_receive_stream : &receive_type::on_receive;
+            };
+
+            if (!context.submit_io(fill, multishot ? nullptr : timeout.get()))
+            {
+                execute_ = &receive_type::on_schedule_complete;
+                context.schedule_pending_io(this);
+            }
+        }
+
+        static void on_receive(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<receive_type*>(op);
+
+            self.stop.disarm();
+            self.deliver();
+
+            self.stop.release();
+        }
+
+        static void on_receive_stream(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<receive_type*>(op);
+
+            if ((self.flags & IORING_CQE_F_MORE) != 0)
+                return self.deliver();
+
+            if (self.result > 0)
+            {
+                self.deliver();
+
+                if (!self.stop.stop_requested())
+                    return self.start_io();
+
+                self.result = -ECANCELED;
+                self.flags = 0;
+            }
+
+            self.stop.disarm();
+            self.deliver();
+
+            self.stop.release();
+        }
+
+        void deliver() noexcept
+        {
+            const bool selected = (flags & IORING_CQE_F_BUFFER) != 0;
+            auto id = static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT);
+
+            if (result > 0 && selected)
+            {
+                if constexpr(Opcode == IORING_OP_RECVMSG)
+                    receiver(std::error_code(), parse(ring.get(id, result)));
+                else
+                    receiver(std::error_code(), ring.get(id, result));
+            }
+            else
+            {
+                if (selected)
+                    ring.recycle(id);
+
+                if (result == 0)
+                    receiver(std::make_error_code(std::errc::no_message), received_buffer());
+                else
+                    receiver(stop.error(result, timeout), received_buffer());
+            }
+        }
+
+        received_buffer parse(received_buffer buffer) noexcept
+        {
+            auto out = reinterpret_cast<io_uring_recvmsg_out*>(buffer.data());
+            std::memcpy(endpoint.data(), out + 1, std::min<std::size_t>(out->namelen, msg.msg_namelen));
+
+            std::size_t offset = sizeof(io_uring_recvmsg_out) + msg.msg_namelen + msg.msg_controllen;
+            std::size_t length = std::min<std::size_t>(out->payloadlen, buffer.size() - offset);
+
+            return {buffer.data() + offset, length, buffer.id};
+        }
+
+        static void on_release(completion_base* op) noexcept
+        {
+            destroy_operation(static_cast<receive_type*>(op));
+        }
+
+        explicit receive_type(io_uring_context& context, int fd, buffer_ring& ring) noexcept : context(context), fd(fd), ring(ring),
+        stop(context, this, &receive_type::on_release)
+        {
+        }
+
+        template <typename F>
+        void async_receive(inplace_stop_token token, F&& f)
+        {
+            receiver = std::forward<F>(f);
+            stop.arm(token);
+
+            start();
+        }
+
+        template <typename F>
+        void async_receive_stream(inplace_stop_token token, F&& f)
+        {
+            multishot = true;
+            async_receive(token, std::forward<F>(f));
+        }
+
+        io_uring_context& context;
+
+        int fd;
+        std::uint8_t sqe_flags = 0;
+
+        buffer_ring& ring;
+        unique_function<void(std::error_code, received_buffer)> receiver;
+
+        bool multishot = false;
+        stop_cancel stop;
+
+        msghdr msg;
+        unp::ip::udp::endpoint endpoint;
+
+        deadline_timeout timeout;
+    };
+
+    using receive_operation = receive_type<IORING_OP_RECV>;
+    using receive_from_operation = receive_type<IORING_OP_RECVMSG>;
+}
+
+#endif
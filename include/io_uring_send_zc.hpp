@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_SEND_ZC_HPP
+#define IO_URING_SEND_ZC_HPP
+
+#include <sys/socket.h>
+
+namespace unp
+{
+    template <io_uring_op opcode>
+    class send_zc_type : private completion_base
+    {
+    public:
+        using buffer_t = std::span<const std::byte>;
+
+        struct notifier : completion_base
+        {
+            explicit notifier(send_zc_type* self) noexcept : self(self)
+            {
+                execute_ = &notifier::on_complete;
+            }
+
+            static void on_complete(operation_base* op) noexcept
+            {
+                auto& n = *static_cast<notifier*>(op);
+                auto& self = *n.self;
+
+                if ((n.flags & IORING_CQE_F_NOTIF) != 0)
+                    return self.on_notification();
+
+                self.result = n.result;
+                self.flags = n.flags;
+
+                on_send_complete(&self);
+            }
+
+            send_zc_type* self;
+        };
+
+        void start() noexcept
+        {
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &send_zc_type::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_io();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<send_zc_type*>(op)->start_io();
+        }
+
+        void start_io() noexcept
+        {
+            assert(context.is_running_on_io_thread());
+
+            if (stop.stop_requested())
+            {
+                result = -ECANCELED;
+
+                return complete();
+            }
+
+            auto fill = [this](io_uring_sqe& sqe) noexcept
+            {
+                sqe.fd = fd;
+                sqe.flags = sqe_flags;
+
+                sqe.msg_flags = MSG_WAITALL;
+
+                if (opcode == IORING_OP_SENDMSG_ZC || (!zero_copy && name != nullptr))
+                {
+                    buff.iov_base = (void*)buffer_.data();
+                    buff.iov_len = buffer_.size();
+
+                    std::memset(&msg, 0, sizeof(msg));
+
+                    msg.msg_name = (void*)name;
+                    msg.msg_namelen = namelen;
+
+                    msg.msg_iov = &buff;
+                    msg.msg_iovlen = 1;
+
+                    sqe.opcode = zero_copy ? IORING_OP_SENDMSG_ZC : IORING_OP_SENDMSG;
+                    sqe.addr = reinterpret_cast<std::uintptr_t>(&msg);
+                }
+                else
+                {
+                    sqe.opcode = zero_copy ? IORING_OP_SEND_ZC : IORING_OP_SEND;
+
+                    sqe.addr = reinterpret_cast<std::uintptr_t>(buffer_.data());
+                    sqe.len = buffer_.size();
+
+                    if (name != nullptr)
+                    {
+                        sqe.addr2 = reinterpret_cast<std::uintptr_t>(name);
+                        sqe.addr_len = namelen;
+                    }
+
+                    if (zero_copy && buf_index >= 0)
+                    {
+                        sqe.ioprio = IORING_RECVSEND_FIXED_BUF;
+                        sqe.buf_index = buf_index;
+                    }
+                }
+
+                if (zero_copy)
+                    stop.target = &notif;
+                else
+                    stop.target = this;
+
+                sqe.user_data = reinterpret_cast<std::uintptr_t>(stop.target);
+
+                execute_ = &send_zc_type::on_send_complete;
+            };
+
+            if (!context.submit_io(fill))
+            {
+                execute_ = &send_zc_type::on_schedule_complete;
+                context.schedule_pending_io(this);
+            }
+            else if (zero_copy)
+                ++notifications;
+        }
+
+        static void on_send_complete(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<send_zc_type*>(op);
+
+            if (self.zero_copy && (self.flags & IORING_CQE_F_MORE) == 0)
+                --self.notifications;
+
+            if (self.zero_copy && self.bytes == 0 && (self.result == -EINVAL || self.result == -EOPNOTSUPP))
+            {
+                self.zero_copy = false;
+
+                return self.start_io();
+            }
+
+            if (self.result > 0)
+            {
+                self.bytes += self.result;
+                self.buffer_ = unp::advance(self.buffer_, self.result);
+
+                if (self.bytes < self.size)
+                    return self.start_io();
+            }
+
+            self.complete();
+        }
+
+        void complete() noexcept
+        {
+            completed = true;
+            stop.disarm();
+
+            if (result < 0)
+                receiver(stop.error(result), bytes);
+            else
+                receiver(std::error_code(), bytes);
+
+            finish();
+        }
+
+        void on_notification() noexcept
+        {
+            assert(notifications > 0);
+            --notifications;
+
+            finish();
+        }
+
+        void finish() noexcept
+        {
+            if (!completed || notifications != 0)
+                return;
+
+            release();
+
+            execute_ = &send_zc_type::on_release;
+            stop.completion = this;
+
+            stop.release();
+        }
+
+        static void on_release(operation_base* op) noexcept
+        {
+            destroy_operation(static_cast<send_zc_type*>(op));
+        }
+
+        explicit send_zc_type(io_uring_context& context, int fd, buffer_t buffer) noexcept :
+        context(context), fd(fd), buffer_(buffer), size(buffer.size()), notif(this), stop(context, this)
+        {
+        }
+
+        template <typename F, typename R>
+        void async_send(F&& f, R&& r)
+        {
+            async_send(inplace_stop_token(), std::forward<F>(f), std::forward<R>(r));
+        }
+
+        template <typename F, typename R>
+        void async_send(inplace_stop_token token, F&& f, R&& r)
+        {
+            receiver = std::forward<F>(f);
+            release = std::forward<R>(r);
+
+            stop.arm(token);
+            start();
+        }
+
+        io_uring_context& context;
+
+        int fd;
+        int buf_index = -1;
+
+        std::uint8_t sqe_flags = 0;
+        buffer_t buffer_;
+
+        const sockaddr* name = nullptr;
+        socklen_t namelen = 0;
+
+        iovec buff;
+        msghdr msg;
+
+        size_t size;
+        size_t bytes = 0;
+
+        bool zero_copy = true;
+        bool completed = false;
+
+        unsigned notifications = 0;
+        notifier notif;
+
+        stop_cancel stop;
+
+        unique_function<void(std::error_code, std::size_t)> receiver;
+        unique_function<void()> release;
+    };
+
+    using send_zc_operation = send_zc_type<IORING_OP_SEND_ZC>;
+    using send_msg_zc_operation = send_zc_type<IORING_OP_SENDMSG_ZC>;
+}
+
+#endif
@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef IO_URING_SHUTDOWN_HPP
+#define IO_URING_SHUTDOWN_HPP
+
+namespace unp
+{
+    class shutdown_operation : private completion_base
+    {
+    public:
+        void start() noexcept
+        {
+            if (!context.is_running_on_io_thread())
+            {
+                execute_ = &shutdown_operation::on_schedule_complete;
+                context.schedule_remote(this);
+            }
+            else
+                start_io();
+        }
+
+        static void on_schedule_complete(operation_base* op) noexcept
+        {
+            static_cast<shutdown_operation*>(op)->start_io();
+        }
+
+        void start_io() noexcept
+        {
+            assert(context.is_running_on_io_thread());
+
+            if (stop.stop_requested())
+            {
+                result = -ECANCELED;
+
+                return on_shutdown(this);
+            }
+
+            auto fill = [this](io_uring_sqe& sqe) noexcept
+            {
+                sqe.opcode = IORING_OP_SHUTDOWN;
+
+                sqe.fd = handle;
+                sqe.flags = sqe_flags;
+
+                sqe.len = how;
+                sqe.user_data = reinterpret_cast<std::uintptr_t>(static_cast<completion_base*>(this));
+
+                execute_ = &shutdown_operation::on_shutdown;
+            };
+
+            if (!context.submit_io(fill))
+            {
+                execute_ = &shutdown_operation::on_schedule_complete;
+                context.schedule_pending_io(this);
+            }
+        }
+
+        static void on_shutdown(operation_base* op) noexcept
+        {
+            auto& self = *static_cast<shutdown_operation*>(op);
+            self.stop.disarm();
+
+            if (self.result >= 0)
+                self.receiver(std::error_code());
+            else
+                self.receiver(self.stop.error(self.result));
+
+            self.stop.release();
+        }
+
+        static void on_release(completion_base* op) noexcept
+        {
+            destroy_operation(static_cast<shutdown_operation*>(op));
+        }
+
+        explicit shutdown_operation(io_uring_context& context, int handle, std::uint8_t sqe_flags, int how) noexcept :
+        context(context), handle(handle), sqe_flags(sqe_flags), how(how), stop(context, this, &shutdown_operation::on_release)
+        {
+        }
+
+        template <typename F>
+        void async_shutdown(F&& f)
+        {
+            async_shutdown(inplace_stop_token(), std::forward<F>(f));
+        }
+
+        template <typename F>
+        void async_shutdown(inplace_stop_token token, F&& f)
+        {
+            receiver = std::forward<F>(f);
+            stop.arm(token);
+
+            start();
+        }
+
+        io_uring_context& context;
+
+        int handle;
+        std::uint8_t sqe_flags;
+
+        int how;
+        stop_cancel stop;
+
+        unique_function<void(std::error_code)> receiver;
+    };
+}
+
+#endif
@@ -44,6 +44,10 @@ namespace unp
                 sqe.off = type;
 
                 sqe.len = protocol;
+
+                if (direct)
+                    sqe.file_index = IORING_FILE_INDEX_ALLOC;
+
                 sqe.user_data = reinterpret_cast<std::uintptr_t>(static_cast<completion_base*>(this));
 
                 execute_ = &socket_operation::on_socket;
@@ -64,16 +68,19 @@ namespace unp
                 self.receiver(std::error_code(), self.result);
             else
                 self.receiver(std::error_code(-self.result, std::system_category()), self.result);
+
+            destroy_operation(&self);
         }
 
-        explicit socket_operation(io_uring_context& context, int domain, int type, int protocol) noexcept : context(context), domain(domain), type(type), protocol(protocol)
+        explicit socket_operation(io_uring_context& context, int domain, int type, int protocol, bool direct = false) noexcept :
+        context(context), domain(domain), type(type), protocol(protocol), direct(direct)
         {
         }
 
         template <typename F>
         void async_socket(F&& f)
         {
-            receiver = f;
+            receiver = std::forward<F>(f);
             start();
         }
 
@@ -83,7 +90,9 @@ namespace unp
         int type;
 
         int protocol;
-        std::function<void(std::error_code, int)> receiver;
+        bool direct;
+
+        unique_function<void(std::error_code, int)> receiver;
     };
 }
 
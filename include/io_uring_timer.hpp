@@ -31,13 +31,13 @@ namespace unp
         static void on_timeout(operation_base* op) noexcept
         {
             auto& self = *static_cast<timer_impl*>(op);
-            self.receiver(std::error_code());
+            self.complete(std::error_code());
         }
 
         static void on_cancel(operation_base* op) noexcept
         {
             auto& self = *static_cast<timer_impl*>(op);
-            self.receiver(std::error_code(ECANCELED, std::system_category()));
+            self.complete(std::error_code(ECANCELED, std::system_category()));
         }
 
         static void remove_timer(operation_base* op) noexcept
@@ -48,7 +48,31 @@ namespace unp
             if ((state & timer_operation::timer_elapsed_flag) == 0)
                 self.context.remove_timer(&self);
 
-            self.receiver(std::error_code(ECANCELED, std::system_category()));
+            self.complete(std::error_code(ECANCELED, std::system_category()));
+        }
+
+        void complete(std::error_code ec) noexcept
+        {
+            state.fetch_or(timer_operation::timer_elapsed_flag, std::memory_order_acq_rel);
+            receiver(ec);
+
+            release();
+        }
+
+        void add_ref() noexcept
+        {
+            refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void release() noexcept
+        {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+
+            if (completion != nullptr)
+                completion->execute_(completion);
+            else
+                destroy_operation(this);
         }
 
         void start_local() noexcept
@@ -114,14 +138,19 @@ namespace unp
         template <typename F>
         void async_wait(F&& f)
         {
-            receiver = f;
+            receiver = std::forward<F>(f);
+            add_ref();
+
             start();
         }
 
         io_uring_context& context;
-
         time_point duetime;
-        std::function<void(std::error_code)> receiver;
+
+        std::atomic<std::uint32_t> refs = 1;
+        operation_base* completion = nullptr;
+
+        unique_function<void(std::error_code)> receiver;
     };
 
     class steady_timer
@@ -131,6 +160,9 @@ namespace unp
         {
         }
 
+        steady_timer(const steady_timer&) = delete;
+        steady_timer& operator=(const steady_timer&) = delete;
+
         void expires_at(const time_point& tp)
         {
             duetime = tp;
@@ -160,18 +192,43 @@ namespace unp
         }
 
         template <typename F>
-        void async_wait(F&& f)
-        {   
+        decltype(auto) async_wait(F&& f)
+        {
+            if constexpr(is_awaitable_v<F>)
+            {
+                auto start = [this](auto f)
+                {
+                    async_wait(std::move(f));
+                };
+
+                return completion_awaiter<decltype(start)>(std::move(start));
+            }
+            else
+                wait(std::forward<F>(f));
+        }
+
+        template <typename F>
+        void wait(F&& f)
+        {
             cancel();
 
-            p = std::make_shared<timer_impl>(context, duetime);
-            p->async_wait([f, this](std::error_code ec){ f(ec); });
+            if (p != nullptr)
+                p->release();
+
+            p = make_operation<timer_impl>(context, duetime);
+            p->async_wait([f = std::forward<F>(f)](std::error_code ec) mutable { f(ec); });
+        }
+
+        ~steady_timer()
+        {
+            if (p != nullptr)
+                p->release();
         }
 
         io_uring_context& context;
 
         time_point duetime;
-        std::shared_ptr<timer_impl> p;
+        timer_impl* p = nullptr;
     };
 }
 
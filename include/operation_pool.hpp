@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef OPERATION_POOL_HPP
+#define OPERATION_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace unp
+{
+    class operation_pool
+    {
+    public:
+        static constexpr std::size_t block_size = 64;
+        static constexpr std::size_t class_count = 16;
+
+        static constexpr std::size_t max_cached = 1024;
+
+        struct block
+        {
+            block* next;
+        };
+
+        struct size_class
+        {
+            block* head = nullptr;
+            std::size_t count = 0;
+
+            std::atomic<block*> remote = nullptr;
+        };
+
+        operation_pool() noexcept
+        {
+        }
+
+        operation_pool(const operation_pool&) = delete;
+        operation_pool& operator=(const operation_pool&) = delete;
+
+        static constexpr std::size_t index_of(std::size_t size) noexcept
+        {
+            return (size + block_size - 1) / block_size - 1;
+        }
+
+        static constexpr bool is_pooled(std::size_t size) noexcept
+        {
+            return size != 0 && index_of(size) < class_count;
+        }
+
+        void* allocate_local(std::size_t size)
+        {
+            if (!is_pooled(size))
+                return ::operator new(size);
+
+            auto& c = classes[index_of(size)];
+
+            if (c.head == nullptr)
+                acquire_remote(c);
+
+            if (c.head == nullptr)
+                return ::operator new((index_of(size) + 1) * block_size);
+
+            auto b = c.head;
+
+            c.head = b->next;
+            --c.count;
+
+            return b;
+        }
+
+        void* allocate_remote(std::size_t size)
+        {
+            return ::operator new(is_pooled(size) ? (index_of(size) + 1) * block_size : size);
+        }
+
+        void deallocate_local(void* p, std::size_t size) noexcept
+        {
+            if (!is_pooled(size))
+                return ::operator delete(p);
+
+            auto& c = classes[index_of(size)];
+
+            if (c.count == max_cached)
+                return ::operator delete(p);
+
+            auto b = static_cast<block*>(p);
+
+            b->next = c.head;
+            c.head = b;
+
+            ++c.count;
+        }
+
+        void deallocate_remote(void* p, std::size_t size) noexcept
+        {
+            if (!is_pooled(size))
+                return ::operator delete(p);
+
+            auto& c = classes[index_of(size)];
+            auto b = static_cast<block*>(p);
+
+            b->next = c.remote.load(std::memory_order_relaxed);
+            while (!c.remote.compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        ~operation_pool()
+        {
+            for (auto& c : classes)
+            {
+                 acquire_remote(c);
+
+                 while (c.head != nullptr)
+                     ::operator delete(std::exchange(c.head, c.head->next));
+            }
+        }
+
+    private:
+        void acquire_remote(size_class& c) noexcept
+        {
+            auto b = c.remote.exchange(nullptr, std::memory_order_acquire);
+
+            while (b != nullptr)
+            {
+                 auto next = b->next;
+
+                 b->next = c.head;
+                 c.head = b;
+
+                 ++c.count;
+                 b = next;
+            }
+        }
+
+        size_class classes[class_count];
+    };
+}
+
+#endif
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef UNIQUE_FUNCTION_HPP
+#define UNIQUE_FUNCTION_HPP
+
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace unp
+{
+    template <typename Signature>
+    class unique_function;
+
+    template <typename R, typename... Args>
+    class unique_function<R(Args...)>
+    {
+    public:
+        static constexpr std::size_t inline_size = 64;
+
+        template <typename F>
+        static constexpr bool is_inline = sizeof(F) <= inline_size && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+        unique_function() noexcept
+        {
+        }
+
+        unique_function(std::nullptr_t) noexcept
+        {
+        }
+
+        template <typename F>
+        requires (!std::is_same_v<std::decay_t<F>, unique_function> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        unique_function(F&& f)
+        {
+            construct(std::forward<F>(f));
+        }
+
+        unique_function(unique_function&& other) noexcept
+        {
+            move_from(other);
+        }
+
+        unique_function& operator=(unique_function&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                move_from(other);
+            }
+
+            return *this;
+        }
+
+        template <typename F>
+        requires (!std::is_same_v<std::decay_t<F>, unique_function> && std::is_invocable_r_v<R, std::decay_t<F>&, Args...>)
+        unique_function& operator=(F&& f)
+        {
+            reset();
+            construct(std::forward<F>(f));
+
+            return *this;
+        }
+
+        unique_function& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+
+            return *this;
+        }
+
+        unique_function(const unique_function&) = delete;
+        unique_function& operator=(const unique_function&) = delete;
+
+        explicit operator bool() const noexcept
+        {
+            return invoke_ != nullptr;
+        }
+
+        R operator()(Args... args)
+        {
+            return invoke_(storage, std::forward<Args>(args)...);
+        }
+
+        void swap(unique_function& other) noexcept
+        {
+            unique_function temp(std::move(other));
+
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        void reset() noexcept
+        {
+            if (manage_ != nullptr)
+                manage_(nullptr, storage);
+
+            invoke_ = nullptr;
+            manage_ = nullptr;
+        }
+
+        ~unique_function()
+        {
+            reset();
+        }
+
+    private:
+        using invoke_fn = R(void*, Args&&...);
+        using manage_fn = void(void*, void*) noexcept;
+
+        template <typename F>
+        void construct(F&& f)
+        {
+            using T = std::decay_t<F>;
+
+            if constexpr(is_inline<T>)
+            {
+                ::new (static_cast<void*>(storage)) T(std::forward<F>(f));
+
+                invoke_ = [](void* p, Args&&... args) -> R
+                {
+                    return std::invoke(*static_cast<T*>(p), std::forward<Args>(args)...);
+                };
+
+                manage_ = [](void* dst, void* src) noexcept
+                {
+                    auto& t = *static_cast<T*>(src);
+
+                    if (dst != nullptr)
+                        ::new (dst) T(std::move(t));
+
+                    t.~T();
+                };
+            }
+            else
+            {
+                ::new (static_cast<void*>(storage)) T*(new T(std::forward<F>(f)));
+
+                invoke_ = [](void* p, Args&&... args) -> R
+                {
+                    return std::invoke(**static_cast<T**>(p), std::forward<Args>(args)...);
+                };
+
+                manage_ = [](void* dst, void* src) noexcept
+                {
+                    auto t = *static_cast<T**>(src);
+
+                    if (dst != nullptr)
+                        ::new (dst) T*(t);
+                    else
+                        delete t;
+                };
+            }
+        }
+
+        void move_from(unique_function& other) noexcept
+        {
+            if (other.manage_ != nullptr)
+                other.manage_(storage, other.storage);
+
+            invoke_ = std::exchange(other.invoke_, nullptr);
+            manage_ = std::exchange(other.manage_, nullptr);
+        }
+
+        alignas(std::max_align_t) unsigned char storage[inline_size];
+
+        invoke_fn* invoke_ = nullptr;
+        manage_fn* manage_ = nullptr;
+    };
+}
+
+#endif
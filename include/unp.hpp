@@ -12,17 +12,32 @@
 
 #include <io_uring_base.hpp>
 #include <io_uring_context.hpp>
+#include <inplace_stop_token.hpp>
+#include <unique_function.hpp>
+#include <io_uring_cancel.hpp>
+#include <io_uring_awaitable.hpp>
+#include <async_scope.hpp>
+#include <io_uring_shutdown.hpp>
 #include <io_uring_file.hpp>
+#include <io_uring_buffer_registry.hpp>
+#include <io_uring_buffer_ring.hpp>
 #include <io_uring_tcp.hpp>
 #include <io_uring_udp.hpp>
 #include <io_uring_read_write.hpp>
+#include <io_uring_send_zc.hpp>
+#include <io_uring_receive.hpp>
 #include <io_uring_datagram.hpp>
+#include <io_uring_datagram_batch.hpp>
+#include <io_uring_chain.hpp>
 #include <io_uring_socket.hpp>
 #include <io_uring_post.hpp>
 #include <io_uring_operation.hpp>
 #include <io_uring_connect.hpp>
 #include <io_uring_accept.hpp>
 #include <io_uring_timer.hpp>
-#include <inplace_stop_token.hpp>
+#include <io_uring_execution.hpp>
+#include <when_all.hpp>
+#include <when_any.hpp>
+#include <io_context_pool.hpp>
 
 #endif
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef WHEN_ALL_HPP
+#define WHEN_ALL_HPP
+
+#include <tuple>
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <system_error>
+#include <inplace_stop_token.hpp>
+#include <manual_lifetime.hpp>
+
+namespace unp::execution
+{
+    template <typename Derived, typename Receiver>
+    class when_base
+    {
+    public:
+        struct forward_stop
+        {
+            void operator()() const noexcept
+            {
+                source->request_stop();
+            }
+
+            inplace_stop_source* source;
+        };
+
+        explicit when_base(Receiver receiver, std::size_t count) : receiver(std::move(receiver)), remaining(count + 1)
+        {
+        }
+
+        when_base(const when_base&) = delete;
+        when_base& operator=(const when_base&) = delete;
+
+        void begin() noexcept
+        {
+            callback.emplace(get_stop_token(receiver), forward_stop{&source});
+        }
+
+        void arrive() noexcept
+        {
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                callback.reset();
+                static_cast<Derived*>(this)->finish();
+            }
+        }
+
+        void fail(std::error_code ec) noexcept
+        {
+            if (!failed.exchange(true, std::memory_order_relaxed))
+                error = ec;
+
+            source.request_stop();
+        }
+
+        Receiver receiver;
+        inplace_stop_source source;
+
+        std::optional<inplace_stop_callback<forward_stop>> callback;
+        std::atomic<std::size_t> remaining;
+
+        std::atomic<bool> failed = false;
+        std::error_code error;
+    };
+
+    template <typename Parent, std::size_t I>
+    struct when_receiver
+    {
+        inplace_stop_token get_stop_token() const noexcept
+        {
+            return parent->source.get_token();
+        }
+
+        template <typename... V>
+        void set_value(V&&... values) noexcept
+        {
+            parent->template on_value<I>(std::forward<V>(values)...);
+        }
+
+        void set_error(std::error_code ec) noexcept
+        {
+            parent->on_error(ec);
+        }
+
+        void set_stopped() noexcept
+        {
+            parent->on_stopped();
+        }
+
+        Parent* parent;
+    };
+
+    template <typename Sender, typename Receiver>
+    using connect_result_t = decltype(std::declval<const Sender&>().connect(std::declval<Receiver>()));
+
+    template <typename Receiver, typename Indices, typename... Senders>
+    class when_all_operation;
+
+    template <typename Receiver, std::size_t... I, typename... Senders>
+    class when_all_operation<Receiver, std::index_sequence<I...>, Senders...> :
+    public when_base<when_all_operation<Receiver, std::index_sequence<I...>, Senders...>, Receiver>
+    {
+    public:
+        using base = when_base<when_all_operation, Receiver>;
+
+        template <std::size_t J>
+        using child_t = connect_result_t<std::tuple_element_t<J, std::tuple<Senders...>>, when_receiver<when_all_operation, J>>;
+
+        explicit when_all_operation(Receiver receiver, const std::tuple<Senders...>& senders) : base(std::move(receiver), sizeof...(Senders))
+        {
+            (std::get<I>(children).construct_with([&]
+            {
+                return std::get<I>(senders).connect(when_receiver<when_all_operation, I>{this});
+            }), ...);
+        }
+
+        void start() noexcept
+        {
+            this->begin();
+            (std::get<I>(children).get().start(), ...);
+
+            this->arrive();
+        }
+
+        template <std::size_t J, typename... V>
+        void on_value(V&&... values) noexcept
+        {
+            std::get<J>(results).emplace(std::forward<V>(values)...);
+            this->arrive();
+        }
+
+        void on_error(std::error_code ec) noexcept
+        {
+            this->fail(ec);
+            this->arrive();
+        }
+
+        void on_stopped() noexcept
+        {
+            stopped.store(true, std::memory_order_relaxed);
+            this->source.request_stop();
+
+            this->arrive();
+        }
+
+        void finish() noexcept
+        {
+            if (this->failed.load(std::memory_order_relaxed))
+                this->receiver.set_error(this->error);
+            else if (stopped.load(std::memory_order_relaxed))
+                this->receiver.set_stopped();
+            else
+            {
+                std::apply([&](auto&... values)
+                {
+                    this->receiver.set_value(std::move(values)...);
+                }, flatten());
+            }
+        }
+
+        auto flatten() noexcept
+        {
+            return std::tuple_cat(std::apply([](auto&... values)
+            {
+                return std::forward_as_tuple(values...);
+            }, *std::get<I>(results))...);
+        }
+
+        ~when_all_operation()
+        {
+            (std::get<I>(children).destruct(), ...);
+        }
+
+        std::atomic<bool> stopped = false;
+
+        std::tuple<manual_lifetime<child_t<I>>...> children;
+        std::tuple<std::optional<typename Senders::value_types>...> results;
+    };
+
+    template <typename... Senders>
+    class when_all_sender
+    {
+    public:
+        using value_types = decltype(std::tuple_cat(std::declval<typename Senders::value_types>()...));
+
+        explicit when_all_sender(Senders... senders) : senders(std::move(senders)...)
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            return when_all_operation<std::decay_t<Receiver>, std::index_sequence_for<Senders...>, Senders...>(std::forward<Receiver>(receiver), senders);
+        }
+
+        std::tuple<Senders...> senders;
+    };
+
+    template <typename... Senders>
+    when_all_sender<std::decay_t<Senders>...> when_all(Senders&&... senders)
+    {
+        return when_all_sender<std::decay_t<Senders>...>(std::forward<Senders>(senders)...);
+    }
+}
+
+#endif
@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2023-present DeepGrace (complex dot invoke at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/deepgrace/unp
+//
+
+#ifndef WHEN_ANY_HPP
+#define WHEN_ANY_HPP
+
+#include <span>
+#include <array>
+#include <variant>
+#include <when_all.hpp>
+
+namespace unp::execution
+{
+    template <typename Receiver, typename Indices, typename... Senders>
+    class when_any_operation;
+
+    template <typename Receiver, std::size_t... I, typename... Senders>
+    class when_any_operation<Receiver, std::index_sequence<I...>, Senders...> :
+    public when_base<when_any_operation<Receiver, std::index_sequence<I...>, Senders...>, Receiver>
+    {
+    public:
+        using base = when_base<when_any_operation, Receiver>;
+        using result_t = std::variant<typename Senders::value_types...>;
+
+        template <std::size_t J>
+        using child_t = connect_result_t<std::tuple_element_t<J, std::tuple<Senders...>>, when_receiver<when_any_operation, J>>;
+
+        explicit when_any_operation(Receiver receiver, const std::tuple<Senders...>& senders) : base(std::move(receiver), sizeof...(Senders))
+        {
+            (std::get<I>(children).construct_with([&]
+            {
+                return std::get<I>(senders).connect(when_receiver<when_any_operation, I>{this});
+            }), ...);
+        }
+
+        void start() noexcept
+        {
+            this->begin();
+            (std::get<I>(children).get().start(), ...);
+
+            this->arrive();
+        }
+
+        template <std::size_t J, typename... V>
+        void on_value(V&&... values) noexcept
+        {
+            if (!won.exchange(true, std::memory_order_acq_rel))
+            {
+                index = J;
+                result.emplace(std::in_place_index<J>, std::forward<V>(values)...);
+
+                this->source.request_stop();
+            }
+
+            this->arrive();
+        }
+
+        void on_error(std::error_code ec) noexcept
+        {
+            if (!this->failed.exchange(true, std::memory_order_relaxed))
+                this->error = ec;
+
+            this->arrive();
+        }
+
+        void on_stopped() noexcept
+        {
+            this->arrive();
+        }
+
+        void finish() noexcept
+        {
+            if (result)
+                this->receiver.set_value(index, std::move(*result));
+            else if (this->failed.load(std::memory_order_relaxed) && !get_stop_token(this->receiver).stop_requested())
+                this->receiver.set_error(this->error);
+            else
+                this->receiver.set_stopped();
+        }
+
+        ~when_any_operation()
+        {
+            (std::get<I>(children).destruct(), ...);
+        }
+
+        std::atomic<bool> won = false;
+        std::size_t index = 0;
+
+        std::tuple<manual_lifetime<child_t<I>>...> children;
+        std::optional<result_t> result;
+    };
+
+    template <typename... Senders>
+    class when_any_sender
+    {
+    public:
+        using value_types = std::tuple<std::size_t, std::variant<typename Senders::value_types...>>;
+
+        explicit when_any_sender(Senders... senders) : senders(std::move(senders)...)
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            return when_any_operation<std::decay_t<Receiver>, std::index_sequence_for<Senders...>, Senders...>(std::forward<Receiver>(receiver), senders);
+        }
+
+        std::tuple<Senders...> senders;
+    };
+
+    template <typename... Senders>
+    when_any_sender<std::decay_t<Senders>...> when_any(Senders&&... senders)
+    {
+        return when_any_sender<std::decay_t<Senders>...>(std::forward<Senders>(senders)...);
+    }
+
+    template <typename Parent>
+    struct when_index_receiver
+    {
+        inplace_stop_token get_stop_token() const noexcept
+        {
+            return parent->source.get_token();
+        }
+
+        template <typename... V>
+        void set_value(V&&... values) noexcept
+        {
+            parent->on_value(index, std::forward<V>(values)...);
+        }
+
+        void set_error(std::error_code ec) noexcept
+        {
+            parent->on_error(ec);
+        }
+
+        void set_stopped() noexcept
+        {
+            parent->on_stopped();
+        }
+
+        Parent* parent;
+        std::size_t index;
+    };
+
+    template <typename Receiver, typename Sender, std::size_t N>
+    class when_any_n_operation : public when_base<when_any_n_operation<Receiver, Sender, N>, Receiver>
+    {
+    public:
+        using base = when_base<when_any_n_operation, Receiver>;
+
+        using value_t = typename Sender::value_types;
+        using child_t = connect_result_t<Sender, when_index_receiver<when_any_n_operation>>;
+
+        explicit when_any_n_operation(Receiver receiver, std::size_t count, const std::array<Sender, N>& senders) :
+        base(std::move(receiver), N), count(count)
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                 children[i].construct_with([&]
+                 {
+                     return senders[i].connect(when_index_receiver<when_any_n_operation>{this, i});
+                 });
+            }
+        }
+
+        void start() noexcept
+        {
+            this->begin();
+
+            for (auto& child : children)
+                 child.get().start();
+
+            this->arrive();
+        }
+
+        template <typename... V>
+        void on_value(std::size_t i, V&&... values) noexcept
+        {
+            auto k = wins.fetch_add(1, std::memory_order_acq_rel);
+
+            if (k < count)
+            {
+                results[i].emplace(std::forward<V>(values)...);
+
+                if (k + 1 == count)
+                    this->source.request_stop();
+            }
+
+            this->arrive();
+        }
+
+        void on_error(std::error_code ec) noexcept
+        {
+            if (!this->failed.exchange(true, std::memory_order_relaxed))
+                this->error = ec;
+
+            this->arrive();
+        }
+
+        void on_stopped() noexcept
+        {
+            this->arrive();
+        }
+
+        void finish() noexcept
+        {
+            if (wins.load(std::memory_order_relaxed) >= count)
+                this->receiver.set_value(std::span<const std::optional<value_t>>(results));
+            else if (this->failed.load(std::memory_order_relaxed) && !get_stop_token(this->receiver).stop_requested())
+                this->receiver.set_error(this->error);
+            else
+                this->receiver.set_stopped();
+        }
+
+        ~when_any_n_operation()
+        {
+            for (auto& child : children)
+                 child.destruct();
+        }
+
+        std::size_t count;
+        std::atomic<std::size_t> wins = 0;
+
+        manual_lifetime<child_t> children[N];
+        std::array<std::optional<value_t>, N> results;
+    };
+
+    template <typename Sender, std::size_t N>
+    class when_any_n_sender
+    {
+    public:
+        using value_types = std::tuple<std::span<const std::optional<typename Sender::value_types>>>;
+
+        explicit when_any_n_sender(std::size_t count, std::array<Sender, N> senders) : count(count), senders(std::move(senders))
+        {
+        }
+
+        template <typename Receiver>
+        auto connect(Receiver&& receiver) const
+        {
+            return when_any_n_operation<std::decay_t<Receiver>, Sender, N>(std::forward<Receiver>(receiver), count, senders);
+        }
+
+        std::size_t count;
+        std::array<Sender, N> senders;
+    };
+
+    template <typename Sender, std::size_t N>
+    when_any_n_sender<Sender, N> when_any_n(std::size_t count, std::array<Sender, N> senders)
+    {
+        assert(count > 0 && count <= N);
+        return when_any_n_sender<Sender, N>(count, std::move(senders));
+    }
+}
+
+#endif